@@ -0,0 +1,224 @@
+////////////////////////////////////////////////////////////////////
+/*
+
+File:			alphabet.cpp
+
+Class impl:		Alphabet
+
+Description:	Letters, case folding and letter scores for a word list language.
+				Words are encoded to one byte codes per letter so the rest of
+				Words works on any alphabet. English (A-Z, Scrabble scores) is
+				built in and its codes are the letters themselves.
+
+Licence:		This program is free software; you can redistribute it and/or modify
+				it under the terms of the GNU General Public License as published by
+				the Free Software Foundation; either version 2 of the License, or
+				(at your option) any later version.
+
+				This software is distributed in the hope that it will be useful,
+				but WITHOUT ANY WARRANTY; without even the implied warranty of
+				MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+				GNU General Public License for more details.
+
+				You should have received a copy of the GNU General Public License
+				along with this program; if not, write to the Free Software
+				Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+////////////////////////////////////////////////////////////////////
+
+#include "alphabet.h"
+#include "helpers.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+static std::vector<std::string> splitSpaces(const std::string &text)
+{
+	std::vector<std::string> items;
+	std::istringstream in(text);
+	std::string item;
+	while (in >> item)
+		items.push_back(item);
+	return items;
+}
+
+Alphabet::Alphabet() : _name("en"), _longest(1)
+{
+	//**English** language Scrabble letter scoring
+	const int scores[26] = { 1,3,3,2,1,4,2,4,1,8,5,1,3,1,1,3,10,1,1,1,1,4,4,8,4,10 };
+	for (int i = 0; i < 26; ++i)
+	{
+		const std::string upper(1, (char)('A' + i));
+		_letters.push_back(upper);
+		_scores.push_back(scores[i]);
+		add(upper, upper);
+		add(std::string(1, (char)('a' + i)), upper);
+	}
+	//digraphs, trigraphs and double letters that make a word easier to spot
+	_stems = splitSpaces("BLE CH CK CI IGH ING OUS QU RH SH SCH SC TH WH WR "
+						 "BB CC DD EE FF GG LL MM NN OO PP RR SS TT UU WW ZZ");
+}
+
+std::shared_ptr<const Alphabet> Alphabet::english()
+{
+	static const tAlphabet en(new Alphabet());
+	return en;
+}
+
+void Alphabet::add(const std::string &spelling, const std::string &codes)
+{
+	_spellings[spelling] = codes;
+	_longest = std::max(_longest, spelling.length());
+}
+
+bool Alphabet::load(const std::string &fileName)
+{
+	std::ifstream in(fileName.c_str());
+	if (!in.is_open())
+	{
+		std::cerr << "Cannot open alphabet file " << fileName << std::endl;
+		return false;
+	}
+
+	std::string line, key, value;
+	std::vector<std::string> letters, lower, scores, folds, stems;
+	std::string name;
+	while (std::getline(in, line))
+	{
+		pptxt::trim(line, " \r\n\t");
+		if (line.empty() || line[0] == '#') continue;
+		pptxt::splitKeyValuePair(line, key, value);
+		if (key == "name") name = value;
+		else if (key == "letters") letters = splitSpaces(value);
+		else if (key == "lower") lower = splitSpaces(value);
+		else if (key == "scores") scores = splitSpaces(value);
+		else if (key == "fold") folds = splitSpaces(value);
+		else if (key == "stems") stems = splitSpaces(value);
+	}
+
+	if (letters.empty() || letters.size() > CODE_MAX)
+	{
+		std::cerr << fileName << ": needs 1 to " << (int)CODE_MAX << " letters" << std::endl;
+		return false;
+	}
+	if ((!lower.empty() && lower.size() != letters.size()) || scores.size() != letters.size())
+	{
+		std::cerr << fileName << ": lower and scores must have one entry per letter" << std::endl;
+		return false;
+	}
+
+	_name = name.empty() ? fileName : name;
+	_letters = letters;
+	_scores.clear();
+	_spellings.clear();
+	_stems.clear();
+	_longest = 1;
+	for (size_t i = 0; i < letters.size(); ++i)
+	{
+		const std::string code(1, (char)(CODE_BASE + i));
+		_scores.push_back(atoi(scores[i].c_str()));
+		add(letters[i], code);
+		if (!lower.empty())
+			add(lower[i], code);
+		else if (letters[i].length() == 1)
+			add(std::string(1, (char)tolower(letters[i][0])), code);
+	}
+	//other spellings, e.g. "ß:SS", after the letters so they can be encoded
+	for (auto &f : folds)
+	{
+		const std::string::size_type pos = f.find(':');
+		const std::string codes = (pos == std::string::npos) ? std::string() : encode(f.substr(pos + 1));
+		if (codes.empty() || !isWord(codes))
+		{
+			std::cerr << fileName << ": bad fold " << f << std::endl;
+			return false;
+		}
+		add(f.substr(0, pos), codes);
+	}
+	for (auto &s : stems)
+	{
+		const std::string codes = encode(s);
+		if (isWord(codes)) _stems.push_back(codes);
+	}
+	return true;
+}
+
+std::string Alphabet::encode(const std::string &text, bool bStrip) const
+{
+	std::string codes;
+	codes.reserve(text.length());
+	for (size_t pos = 0; pos < text.length(); )
+	{
+		//longest spelling first, so multi-byte letters and folds win
+		size_t len = std::min(_longest, text.length() - pos);
+		for (; len > 0; --len)
+		{
+			auto it = _spellings.find(text.substr(pos, len));
+			if (it != _spellings.end())
+			{
+				codes += it->second;
+				break;
+			}
+		}
+		if (len == 0)
+		{
+			if (!bStrip) codes += (char)NOT_A_LETTER;
+			len = 1;
+		}
+		pos += len;
+	}
+	return codes;
+}
+
+std::string Alphabet::decode(const std::string &word) const
+{
+	std::string letters;
+	for (auto c : word)
+	{
+		const int n = (unsigned char)c - CODE_BASE;
+		letters += (n >= 0 && n < (int)_letters.size()) ? _letters[n] : std::string(1, c);
+	}
+	return letters;
+}
+
+bool Alphabet::isWord(const std::string &word) const
+{
+	for (auto c : word)
+	{
+		const int n = (unsigned char)c - CODE_BASE;
+		if (n < 0 || n >= (int)_letters.size()) return false;
+	}
+	return true;
+}
+
+int Alphabet::score(char code) const
+{
+	const int n = (unsigned char)code - CODE_BASE;
+	return (n >= 0 && n < (int)_scores.size()) ? _scores[n] : 0;
+}
+
+//remove the letter groups that make a word easier to spot, leaving its 'stem'
+std::string Alphabet::stem(const std::string &word) const
+{
+	std::string out;
+	for (size_t pos = 0; pos < word.length(); )
+	{
+		size_t len = 0;
+		for (auto &s : _stems)
+		{
+			if (word.compare(pos, s.length(), s) == 0)
+			{
+				len = s.length();
+				break;
+			}
+		}
+		if (len)
+			pos += len;
+		else
+			out += word[pos++];
+	}
+	return out;
+}
@@ -0,0 +1,60 @@
+//alphabet.h
+//
+//The letters of a word list's language. Words are held by Words as one byte
+//per letter, the letter's code, so word lengths, sub-word matching and the
+//word sets work the same for any alphabet. For the built in English alphabet
+//the codes are just the letters A-Z, so nothing changes for the game; other
+//languages are read from a .alphabet file by rewordlist:
+//
+//	name=de
+//	letters=A B C ... Z Ä Ö Ü		upper case, in code order (UTF-8)
+//	lower=a b c ... z ä ö ü			optional, same order (ASCII is folded anyway)
+//	fold=ß:SS						optional, more spellings of a letter or letters
+//	scores=1 3 4 ... 6 8 6			letter values for the skill level, same order
+//	stems=SCH CH CK					optional, letter groups ignored by the skill level
+
+#if !defined ALPHABET_H
+#define ALPHABET_H
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+class Alphabet
+{
+public:
+	Alphabet();								//English
+
+	bool		load(const std::string &fileName);
+	const std::string &	name() const { return _name; }
+	size_t		size() const { return _letters.size(); }
+
+	//letters to codes. Anything that isn't a letter is dropped if bStrip, else
+	//becomes NOT_A_LETTER, below every code, so isWord() rejects the word. (Kept
+	//as it was, a '[' or a Latin A could land on another alphabet's codes)
+	std::string	encode(const std::string &text, bool bStrip = false) const;
+	std::string	decode(const std::string &word) const;		//codes back to upper case letters
+	bool		isWord(const std::string &word) const;		//all letter codes
+
+	int			score(char code) const;
+	std::string	stem(const std::string &word) const;		//word without its stems
+
+	static std::shared_ptr<const Alphabet> english();
+
+private:
+	enum { CODE_BASE = 'A', CODE_MAX = 64, NOT_A_LETTER = '?' };
+
+	void		add(const std::string &spelling, const std::string &codes);
+
+	std::string	_name;
+	std::vector<std::string>	_letters;	//by code
+	std::vector<int>			_scores;	//by code
+	std::vector<std::string>	_stems;		//as codes, in match order
+	std::map<std::string, std::string>	_spellings;	//UTF-8 spelling to codes
+	size_t		_longest;					//longest spelling, in bytes
+};
+
+typedef std::shared_ptr<const Alphabet> tAlphabet;
+
+#endif //ALPHABET_H
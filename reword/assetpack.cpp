@@ -0,0 +1,293 @@
+////////////////////////////////////////////////////////////////////
+/*
+
+File:			assetpack.cpp
+
+Class impl:		AssetPack
+
+Description:	A single binary file holding the decoded pixels of every image
+				(fonts pages included) already converted to the renderers texture
+				format, plus the parsed BMFont metrics. Built by running the game
+				with "-bake", which records everything loaded during init and
+				writes it out. At startup the pack is read in one go and surfaces
+				point straight into it, so the png decodes and the xml parsing are
+				skipped. If the pack is missing (or from another version) the normal
+				file loading is used, so it is purely optional. Each entry keeps the
+				size and time of the file it was baked from, and is dropped once
+				that file has changed, so a stale pack never hides an edit.
+
+				Layout (native byte order, marker checked on load):
+					"RWPK" version byteorder count
+					count * [namelen name type offset len w h pitch format srcsize srctime]
+					data (each entry 4 byte aligned)
+
+Licence:		This program is free software; you can redistribute it and/or modify
+				it under the terms of the GNU General Public License as published by
+				the Free Software Foundation; either version 2 of the License, or
+				(at your option) any later version.
+
+				This software is distributed in the hope that it will be useful,
+				but WITHOUT ANY WARRANTY; without even the implied warranty of
+				MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+				GNU General Public License for more details.
+
+				You should have received a copy of the GNU General Public License
+				along with this program; if not, write to the Free Software
+				Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+////////////////////////////////////////////////////////////////////
+
+#include "assetpack.h"
+#include "platform.h"
+
+#include <sys/stat.h>
+
+#include <fstream>
+#include <iostream>
+#include <cstring>
+
+#define PACK_MAGIC      "RWPK"
+#define PACK_VERSION    2   //1 had no source file size and time
+#define PACK_BYTEORDER  0x01020304
+
+AssetPack::AssetPack() : _bRecord(false), _format(SDL_PIXELFORMAT_ARGB8888)
+{
+}
+
+AssetPack::~AssetPack()
+{
+    close();
+}
+
+//read the whole pack into memory with a single read and index the entries
+bool AssetPack::open(const std::string &packFile)
+{
+    close();
+
+    std::ifstream infile(packFile.c_str(), std::ios::in | std::ios::binary | std::ios::ate);
+    if (!infile.is_open())
+        return false;   //not baked, that's ok
+
+    const std::streamoff size = infile.tellg();
+    if (size < 16)
+        return false;
+    _blob.resize((size_t)size);
+    infile.seekg(0);
+    if (!infile.read(reinterpret_cast<char *>(&_blob[0]), size))
+    {
+        _blob.clear();
+        return false;
+    }
+
+    Uint32 hdr[3];
+    memcpy(hdr, &_blob[4], sizeof(hdr));
+    if (memcmp(&_blob[0], PACK_MAGIC, 4) != 0 || hdr[0] != PACK_VERSION || hdr[1] != PACK_BYTEORDER)
+    {
+        std::cout << "Asset pack " << packFile << " is not valid for this build, ignoring it" << std::endl;
+        _blob.clear();
+        return false;
+    }
+
+    //table of contents, offsets are relative to the data following it
+    size_t pos = 16;
+    for (Uint32 i = 0; i < hdr[2]; ++i)
+    {
+        Uint16 nameLen(0);
+        if (pos + sizeof(nameLen) > _blob.size()) break;
+        memcpy(&nameLen, &_blob[pos], sizeof(nameLen));
+        pos += sizeof(nameLen);
+
+        SEntry e;
+        if (pos + nameLen + sizeof(e) > _blob.size()) break;
+        std::string name(reinterpret_cast<const char *>(&_blob[pos]), nameLen);
+        pos += nameLen;
+        memcpy(&e, &_blob[pos], sizeof(e));
+        pos += sizeof(e);
+        _entries[name] = e;
+    }
+    pos = (pos + 3) & ~3;
+
+    //make the offsets absolute and drop anything pointing past the end, or
+    //baked from a file that has been edited since
+    size_t stale = 0;
+    for (auto it = _entries.begin(); it != _entries.end(); )
+    {
+        if (!isSane(it->second, pos, _blob.size()))
+        {
+            std::cerr << "Asset pack entry " << it->first << " is corrupt, ignoring it" << std::endl;
+            it = _entries.erase(it);
+        }
+        else if (isStale(it->first, it->second))
+        {
+            it = _entries.erase(it);
+            ++stale;
+        }
+        else
+            ++it;
+    }
+
+    std::cout << "Asset pack " << packFile << " loaded, " << _entries.size() << " entries";
+    if (stale) std::cout << " (" << stale << " older than their files, loading those instead)";
+    std::cout << std::endl;
+    return true;
+}
+
+void AssetPack::close()
+{
+    _entries.clear();
+    std::vector<Uint8>().swap(_blob);   //actually release the memory
+}
+
+//write everything captured while recording
+bool AssetPack::save(const std::string &packFile)
+{
+    std::ofstream outfile(packFile.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!outfile.is_open())
+    {
+        std::cerr << "Failed to create asset pack " << packFile << std::endl;
+        return false;
+    }
+
+    std::vector<Uint8> out;
+    out.insert(out.end(), PACK_MAGIC, PACK_MAGIC + 4);
+    const Uint32 hdr[3] = { PACK_VERSION, PACK_BYTEORDER, (Uint32)_bakedEntries.size() };
+    out.insert(out.end(), reinterpret_cast<const Uint8 *>(hdr), reinterpret_cast<const Uint8 *>(hdr) + sizeof(hdr));
+    for (auto &it : _bakedEntries)
+    {
+        const Uint16 nameLen = (Uint16)it.first.length();
+        out.insert(out.end(), reinterpret_cast<const Uint8 *>(&nameLen), reinterpret_cast<const Uint8 *>(&nameLen) + sizeof(nameLen));
+        out.insert(out.end(), it.first.begin(), it.first.end());
+        out.insert(out.end(), reinterpret_cast<const Uint8 *>(&it.second), reinterpret_cast<const Uint8 *>(&it.second) + sizeof(SEntry));
+    }
+    out.resize((out.size() + 3) & ~3, 0);
+    out.insert(out.end(), _baked.begin(), _baked.end());
+
+    outfile.write(reinterpret_cast<const char *>(&out[0]), out.size());
+    std::cout << "Asset pack " << packFile << " saved, " << _bakedEntries.size() << " entries, "
+        << out.size() << " bytes" << std::endl;
+    return outfile.good();
+}
+
+void AssetPack::setRecording(bool bRecord, Uint32 pixelFormat)
+{
+    _bRecord = bRecord;
+    _format = pixelFormat;
+    if (!_bRecord)
+    {
+        _bakedEntries.clear();
+        std::vector<Uint8>().swap(_baked);
+    }
+}
+
+//a surface using the pack memory directly (no copy), or nullptr if not in the pack
+SDL_Surface * AssetPack::getSurface(const std::string &fileName) const
+{
+    auto it = _entries.find(key(fileName));
+    if (it == _entries.end() || it->second.type != ENTRY_IMAGE)
+        return nullptr;
+
+    const SEntry &e = it->second;
+    SDL_Surface *s = SDL_CreateRGBSurfaceWithFormatFrom(const_cast<Uint8 *>(&_blob[e.offset]),
+                                                        e.w, e.h, SDL_BITSPERPIXEL(e.format), e.pitch, e.format);
+    if (s)
+        SDL_SetSurfaceBlendMode(s, SDL_BLENDMODE_BLEND);
+    return s;
+}
+
+//convert to the texture format now so the upload at startup is a straight copy
+void AssetPack::putSurface(const std::string &fileName, SDL_Surface *s)
+{
+    if (!_bRecord || nullptr == s) return;
+
+    SDL_Surface *conv = SDL_ConvertSurfaceFormat(s, _format, 0);
+    if (nullptr == conv)
+    {
+        std::cerr << "Asset pack failed to convert " << fileName << " : " << SDL_GetError() << std::endl;
+        return;
+    }
+
+    SEntry e = { ENTRY_IMAGE, (Uint32)_baked.size(), (Uint32)(conv->pitch * conv->h),
+                 (Uint32)conv->w, (Uint32)conv->h, (Uint32)conv->pitch, _format, 0, 0 };
+    source(fileName, e);
+    SDL_LockSurface(conv);
+    const Uint8 *pixels = static_cast<const Uint8 *>(conv->pixels);
+    _baked.insert(_baked.end(), pixels, pixels + e.len);
+    SDL_UnlockSurface(conv);
+    SDL_FreeSurface(conv);
+
+    _baked.resize((_baked.size() + 3) & ~3, 0);
+    _bakedEntries[key(fileName)] = e;
+}
+
+bool AssetPack::getData(const std::string &fileName, const Uint8 *&data, Uint32 &len) const
+{
+    auto it = _entries.find(key(fileName));
+    if (it == _entries.end() || it->second.type != ENTRY_DATA)
+        return false;
+
+    data = &_blob[it->second.offset];
+    len = it->second.len;
+    return true;
+}
+
+void AssetPack::putData(const std::string &fileName, const std::vector<Uint8> &data)
+{
+    if (!_bRecord) return;
+
+    SEntry e = { ENTRY_DATA, (Uint32)_baked.size(), (Uint32)data.size(), 0, 0, 0, 0, 0, 0 };
+    source(fileName, e);
+    _baked.insert(_baked.end(), data.begin(), data.end());
+    _baked.resize((_baked.size() + 3) & ~3, 0);
+    _bakedEntries[key(fileName)] = e;
+}
+
+//make the entry's offset absolute, if it and (for an image) its rows are all
+//inside the pack. Done in 64 bits so a corrupt offset or size can't wrap
+bool AssetPack::isSane(SEntry &e, size_t pos, size_t blobSize)
+{
+    const Uint64 start = (Uint64)pos + e.offset;
+    if (start + e.len > blobSize || start + e.len > 0xFFFFFFFFull)
+        return false;
+    if (ENTRY_IMAGE == e.type)
+    {
+        const Uint64 bpp = SDL_BYTESPERPIXEL(e.format);
+        if (0 == bpp || 0 == e.w || 0 == e.h || (Uint64)e.pitch < e.w * bpp
+            || (Uint64)e.pitch * e.h > e.len)
+            return false;
+    }
+    else if (ENTRY_DATA != e.type)
+        return false;
+    e.offset = (Uint32)start;
+    return true;
+}
+
+//size and modified time of the file, false (and 0) if it can't be read
+bool AssetPack::source(const std::string &fileName, SEntry &e)
+{
+    struct stat st;
+    const bool bOk = (stat(fileName.c_str(), &st) == 0);
+    e.srcSize = bOk ? (Uint32)st.st_size : 0;
+    e.srcTime = bOk ? (Uint32)st.st_mtime : 0;
+    return bOk;
+}
+
+//true if the entry's file is there and isn't the one it was baked from. If
+//it's not there the pack is all there is, so that's fine
+bool AssetPack::isStale(const std::string &name, const SEntry &e)
+{
+    SEntry now = e;
+    if (!source(RES_BASE + name, now) && !source(name, now))
+        return false;   //key() keeps any path outside RES_BASE as it was
+    return now.srcSize != e.srcSize || now.srcTime != e.srcTime;
+}
+
+//entries are stored relative to the platform data dir so the pack
+//doesn't depend on where the game was run from
+std::string AssetPack::key(const std::string &fileName)
+{
+    const std::string base = RES_BASE;
+    if (fileName.compare(0, base.length(), base) == 0)
+        return fileName.substr(base.length());
+    return fileName;
+}
@@ -0,0 +1,67 @@
+//assetpack.h
+//
+//Single binary blob of pre-decoded images and pre-parsed font metrics,
+//baked offline by running "reword -bake" so startup can skip the png
+//decodes and the BMFont xml parsing.
+
+#if !defined ASSETPACK_H
+#define ASSETPACK_H
+
+#include <SDL.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+class AssetPack
+{
+public:
+    AssetPack();
+    ~AssetPack();
+
+    bool open(const std::string &packFile);  //read whole pack in one go, false if missing/stale
+    void close();                           //free the blob once startup loading is done
+    bool save(const std::string &packFile);
+    bool isOpen() const { return !_blob.empty(); }
+    bool has(const std::string &fileName) const { return _entries.count(key(fileName)) != 0; }
+
+    //while recording (bake mode) every image and font loaded is captured
+    void setRecording(bool bRecord, Uint32 pixelFormat = SDL_PIXELFORMAT_ARGB8888);
+    bool isRecording() const { return _bRecord; }
+
+    //pixels are returned as a surface pointing straight into the blob, so the
+    //surface must be freed (or converted to a texture) before close()
+    SDL_Surface * getSurface(const std::string &fileName) const;
+    void putSurface(const std::string &fileName, SDL_Surface *s);
+
+    //raw data, eg. font metrics serialised by FontTTF
+    bool getData(const std::string &fileName, const Uint8 *&data, Uint32 &len) const;
+    void putData(const std::string &fileName, const std::vector<Uint8> &data);
+
+    static std::string key(const std::string &fileName);    //path relative to RES_BASE
+
+protected:
+    enum eEntryType { ENTRY_DATA = 1, ENTRY_IMAGE = 2 };
+    struct SEntry
+    {
+        Uint32  type;
+        Uint32  offset;     //into _blob (or _baked when recording)
+        Uint32  len;
+        Uint32  w, h, pitch, format;    //images only
+        Uint32  srcSize, srcTime;       //of the file it was baked from, so an edited one is seen
+    };
+    typedef std::map<std::string, SEntry> tEntryMap;
+
+    static bool isSane(SEntry &e, size_t pos, size_t blobSize);
+    static bool source(const std::string &fileName, SEntry &e);
+    static bool isStale(const std::string &name, const SEntry &e);
+
+    tEntryMap           _entries;
+    std::vector<Uint8>  _blob;      //loaded pack
+    std::vector<Uint8>  _baked;     //data captured while recording
+    tEntryMap           _bakedEntries;
+    bool                _bRecord;
+    Uint32              _format;    //pixel format baked images are converted to
+};
+
+#endif //ASSETPACK_H
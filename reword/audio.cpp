@@ -43,18 +43,19 @@ Licence:		This program is free software; you can redistribute it and/or modify
 #include "helpers.h"
 #include "utils.h"
 #include "platform.h"
+#include "resource.h"
 
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <fcntl.h>
 #include <stdio.h>
 #include <iostream>
+#include <algorithm>
 
 #if !defined WIN32
 #include <sys/ioctl.h>
 #include <unistd.h> //for close()
 #include <linux/soundcard.h>
-#include <dirent.h>		//for dir search for songs...
 #endif
 
 #include <SDL_mixer.h>
@@ -70,7 +71,12 @@ void NullAudio::setup(bool, bool, const std::string &, bool)
 /////////////////////////////////////////////////////////////////////////////////////////////
 
 
-Audio::Audio() : _init(false), _volTest(0), _musicTrack(0), _lastTrack(0), _bPlayingTrack(false)
+//mixer channels for each IAudio::eSfxPriority, low to high
+static const int _sfxChannels[IAudio::SFX_PRI_MAX] = { 3, 4, 1 };
+
+Audio::Audio() : _init(false), _volTest(0), _musicTrack(0), _lastTrack(0), _bPlayingTrack(false),
+    _bufferSamples(0), _freq(0), _channels(0), _format(0),
+    _mixCalls(0), _mixBytes(0), _mixFirst(0), _mixLast(0)
 {
 	_baseTrackDir = RES_MUSIC;
 	_sfxVolSave = _musicVolSave = 0;
@@ -80,9 +86,15 @@ Audio::~Audio()
 {
     closedown();
 }
+//changed from the options screen once running, so find the tracks in the new dir
 void Audio::setBaseTrackDir(const std::string &baseTrackDir)
 {
+	if (baseTrackDir == _baseTrackDir) return;
 	_baseTrackDir = baseTrackDir;
+	if (!_init) return;     //setup() indexes it
+
+	_lastTrack = 0;         //start from the first track of the new list
+	loadTracks(_baseTrackDir);
 }
 
 //pass in default options for music and sfx from options screen, and any mute option from
@@ -94,12 +106,23 @@ void Audio::setup(bool bSfx, bool bMusic, const std::string &baseTrackDir, bool
 	//open audio with chunksize of 128 for gp2x, as smaller this is,
 	//the more often the sound hooks will be called, reducing lag
 	//e.g Mix_OpenAudio(22050, AUDIO_S16, 2, 2048)
-	if (Mix_OpenAudio(SOUND_FREQUENCY, SOUND_FORMAT, SOUND_CHANELS, SOUND_CHUNK) == -1)
+	//SDL wants a power of 2, so round any -audiobuf size up to one
+	int chunk = SOUND_CHUNK;
+	if (_bufferSamples > 0)
+        for (chunk = 64; chunk < _bufferSamples && chunk < 8192; chunk <<= 1) ;
+	if (Mix_OpenAudio(SOUND_FREQUENCY, SOUND_FORMAT, SOUND_CHANELS, chunk) == -1)
 	{
 		//setLastError("Warning: Couldn't set audio\nReason: %s\n");
 		return;	//not set _init
 	}
 
+	//what we actually got, which the sfx are converted to as they load
+	Mix_QuerySpec(&_freq, &_format, &_channels);
+	std::cout << "Audio " << _freq << "Hz " << SDL_AUDIO_BITSIZE(_format) << "bit x" << _channels
+        << ", buffer " << chunk << " samples (" << (chunk * 1000 / std::max(_freq, 1)) << "ms)" << std::endl;
+	Mix_SetPostMix(postMix, this);     //to measure the real buffer size and rate
+	allocateChannels();
+
 	_opt._bMusic = bMusic && !bMute;  //music on or off
 	_opt._bSfx = bSfx && !bMute;      //sfx on or off
 
@@ -139,21 +162,36 @@ void Audio::closedown()
 //#endif
 
     stopTrack();
+    _tracks.close();
 
 	Mix_FreeChunk(_volTest);
+	_volTest = nullptr;
     Mix_FreeMusic(_musicTrack);
+    _musicTrack = nullptr;
 
-    std::vector<Mix_Chunk *>::iterator it = _sfxList.begin();
-    std::vector<Mix_Chunk *>::iterator end = _sfxList.end();
-    for ( ; it!=end; ++it)
+    for (size_t n = 0; n < _sfxList.size(); ++n)
     {
-        Mix_FreeChunk((*it));
-        (*it) = nullptr;
+        //shared chunks only freed by the first id using them
+        bool bFirst = true;
+        for (size_t prev = 0; prev < n && bFirst; ++prev)
+            bFirst = _sfxList[prev].chunk != _sfxList[n].chunk;
+        if (bFirst)
+            Mix_FreeChunk(_sfxList[n].chunk);
     }
     _sfxList.clear();
 
 	if (_init)
 	{
+        Mix_SetPostMix(nullptr, nullptr);
+        const Uint32 calls = _mixCalls;
+        if (calls > 1 && _channels > 0)
+        {
+            //latency a sound waits in the mixer buffer, from the buffers actually asked for
+            const int frameBytes = SDL_AUDIO_BITSIZE(_format) / 8 * _channels;
+            const Uint32 samples = _mixBytes / calls / frameBytes;
+            std::cout << "Audio mixed " << samples << " samples a buffer (" << (samples * 1000 / _freq)
+                << "ms latency), every " << (_mixLast - _mixFirst) / (calls - 1) << "ms" << std::endl;
+        }
         Mix_CloseAudio();
 	}
 
@@ -223,7 +261,42 @@ void Audio::setVolume(Sint16 newvol, bool bTest)
 	if (newvol > 0) _sfxVolSave = _musicVolSave = newvol;
 
 	//play a test beep/sound at the new volume so player can tell
-	if (bTest && !isMute()) Mix_PlayChannel(-1,_volTest,0);
+	if (bTest && !isMute()) Mix_PlayChannel(channelFor(SFX_PRI_HIGH),_volTest,0);
+}
+
+//split the mixer channels into a group per priority
+void Audio::allocateChannels()
+{
+    int total = 0;
+    for (auto n : _sfxChannels) total += n;
+    Mix_AllocateChannels(total);
+
+    int from = 0;
+    for (int pri = 0; pri < SFX_PRI_MAX; ++pri)
+    {
+        Mix_GroupChannels(from, from + _sfxChannels[pri] - 1, pri);
+        from += _sfxChannels[pri];
+    }
+}
+
+//a free channel for this priority, or its oldest if they're all busy
+int Audio::channelFor(eSfxPriority pri)
+{
+    int channel = Mix_GroupAvailable(pri);
+    if (channel == -1)
+        channel = Mix_GroupOldest(pri);
+    return channel;
+}
+
+//mixer thread, once per buffer. Nothing but counting here
+void Audio::postMix(void *udata, Uint8 *, int len)
+{
+    Audio *pAudio = static_cast<Audio *>(udata);
+    const Uint32 now = SDL_GetTicks();
+    if (pAudio->_mixCalls++ == 0)
+        pAudio->_mixFirst = now;
+    pAudio->_mixLast = now;
+    pAudio->_mixBytes += len;
 }
 
 /*
@@ -391,7 +464,9 @@ void Audio::startTrack(const std::string &trackName)
 		printf("Play: %s\n", trackName.c_str());
 		std::string newTrack = _baseTrackDir + "/" + trackName;
         Mix_FreeMusic(_musicTrack);
-		_musicTrack = Mix_LoadMUS(newTrack.c_str());
+		_musicTrack = _tracks.take(trackName);	//normally loaded while the last one played
+		if (!_musicTrack)
+			_musicTrack = Mix_LoadMUS(newTrack.c_str());
 		if(_musicTrack)
 		{
 			Mix_PlayMusic(_musicTrack, 1);
@@ -401,6 +476,16 @@ void Audio::startTrack(const std::string &trackName)
 			printf("Failed to start track %s (%s)\n", newTrack.c_str(), Mix_GetError());
 
 		Mix_HookMusicFinished(AudioTrackDone);	//reiterate callback
+
+		//get the tracks either side ready, for when this one ends or is skipped
+		const int nTracks = (int)_tracks.size();
+		if (nTracks > 1)
+		{
+			std::vector<std::string> next;
+			next.push_back(_tracks.name(_lastTrack % nTracks));
+			next.push_back(_tracks.name((_lastTrack + nTracks - 2) % nTracks));
+			_tracks.prefetch(next);
+		}
 	}
 	if (!_bPlayingTrack)
 	{
@@ -421,53 +506,50 @@ void Audio::pauseTrack()
 
 std::string Audio::getNextTrack()
 {
-	if (_trackList.size() == 0) return "";	//no tracks
+	const int nTracks = (int)_tracks.size();
+	if (nTracks == 0) return "";	//no tracks (or not found yet)
 
-	if (++_lastTrack > (int)_trackList.size()) _lastTrack=1;
-	return _trackList[_lastTrack-1];
+	if (++_lastTrack > nTracks) _lastTrack=1;
+	return _tracks.name(_lastTrack-1);
 }
 
 std::string Audio::getPrevTrack()
 {
-	if (_trackList.size() == 0) return "";	//no tracks
+	const int nTracks = (int)_tracks.size();
+	if (nTracks == 0) return "";	//no tracks (or not found yet)
 
-	if (--_lastTrack < 1) _lastTrack=_trackList.size();
-	return _trackList[_lastTrack-1];
+	if (--_lastTrack < 1) _lastTrack=nTracks;
+	return _tracks.name(_lastTrack-1);
 }
 
+//find the tracks in the background, so a big music dir doesn't hold up startup
 void Audio::loadTracks(const std::string &baseDir)
 {
-#ifndef WIN32
-	struct dirent *dir;
-	DIR *d = opendir(baseDir.c_str());
-	if (d)
-	{
-		while ((dir = readdir(d)) != nullptr)
-		{
-			std::string sTrack = dir->d_name;
-			if (sTrack.length()>0 && sTrack[0] != '.')
-			{
-				if (pptxt::endsWith(sTrack, "OGG") || pptxt::endsWith(sTrack, "MP3"))
-				{
-					printf("%s\n", sTrack.c_str());
-					_trackList.push_back(sTrack);
-				}
-			}
-		}
-		closedir(d);
-	}
-#else
-	//TODO - load tracks on MS box
-#endif
+	_tracks.index(baseDir);
 }
 
-//add a sound effect to the resource list and check required position is correct
-int Audio::addSfx(const std::string &filename, unsigned int reqPos)
+//add a sound effect to the resource list and check required position is correct.
+//A file already added for another id is shared, not loaded again
+int Audio::addSfx(const std::string &filename, unsigned int reqPos, eSfxPriority pri)
 {
-    Mix_Chunk *pMix = Mix_LoadWAV(std::string(RES_SOUNDS + filename).c_str());
-    if (!pMix) return -1;
+    Mix_Chunk *pMix = nullptr;
+    for (auto &sfx : _sfxList)
+        if (sfx.name == filename) { pMix = sfx.chunk; break; }
+
+    if (!pMix)
+    {
+        const std::string fullName = RES_SOUNDS + filename;
+        pMix = Resource::loader().takeSound(fullName);   //preloaded at startup?
+        if (!pMix)
+            pMix = Mix_LoadWAV(fullName.c_str());
+        if (!pMix) return -1;
+    }
 
-    _sfxList.push_back(pMix);
+    SSfx sfx;
+    sfx.name = filename;
+    sfx.chunk = pMix;
+    sfx.pri = pri;
+    _sfxList.push_back(sfx);
     const bool bOk= (_sfxList.size() == reqPos+1);
 
 #if _DEBUG
@@ -481,17 +563,18 @@ std::cout << "# of sounds " << _sfxList.size() << " - added " << filename << (bO
 void Audio::playSfx(unsigned int iSnd, unsigned int count)
 {
     if (iSnd < _sfxList.size() && sfxEnabled())
-        Mix_PlayChannel(-1, _sfxList[iSnd], count);
+        Mix_PlayChannel(channelFor(_sfxList[iSnd].pri), _sfxList[iSnd].chunk, count);
 }
 
 //slower lookup using original name of sound file
 void Audio::playSfx(const std::string &sound, unsigned int count)
 {
-    (void)(sound);
-    (void)(count);
-    //********NOT IMPLEMENTED YET********
-//    if (sfxEnabled())
-//        Mix_PlayChannel(-1, _volTest, 0);
+    for (unsigned int n = 0; n < _sfxList.size(); ++n)
+        if (_sfxList[n].name == sound)
+        {
+            playSfx(n, count);
+            return;
+        }
 }
 
 #ifdef _USE_MIKMOD
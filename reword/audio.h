@@ -6,11 +6,13 @@
 #include "i_audio.h"    //interface
 
 #include "error.h"
+#include "tracklibrary.h"
 #include <SDL_mixer.h>
 #include <string>
 #include <deque>
 #include <memory>
 #include <vector>
+#include <atomic>
 
 #ifdef _USE_MIKMOD
 #include <mikmod.h>
@@ -26,6 +28,7 @@ public:
     NullAudio() {}
 	virtual ~NullAudio() {}
 
+    virtual void setBufferSize(int samples) { (void)(samples); }
 	virtual void setup(bool bSfx, bool bMusic, const std::string &baseTrackDir, bool bMute);
 	virtual void closedown() {}
 
@@ -63,7 +66,7 @@ public:
 	virtual bool isPlayingMusic() { return false; }
 	virtual bool isActuallyPlayingMusic() { return false; }
 
-    virtual int addSfx(const std::string &, unsigned int) { return -1; }
+    virtual int addSfx(const std::string &, unsigned int, eSfxPriority) { return -1; }
 	virtual void playSfx(unsigned int, unsigned int = 0) {}
 	virtual void playSfx(const std::string &, unsigned int = 0) {}
 };
@@ -89,6 +92,7 @@ class Audio : public IAudio
 public:
 	Audio();
 	virtual ~Audio();
+    virtual void setBufferSize(int samples) { _bufferSamples = samples; }
 	virtual void setup(bool bSfx, bool bMusic, const std::string &baseTrackDir, bool bMute);
 	virtual void closedown();
 
@@ -116,7 +120,7 @@ public:
     virtual bool toggleMuteAll(bool bIsMenu = false);
 
     virtual bool hasSound() { return true; }    //always as this is NOT NullAudio
-	virtual bool hasMusicTracks() { return _trackList.size() > 0; }
+	virtual bool hasMusicTracks() { return _tracks.size() > 0; }
 	virtual void setBaseTrackDir(const std::string &baseMusicDir);
 	virtual void startNextTrack();
 	virtual void startPrevTrack();
@@ -126,7 +130,7 @@ public:
 	virtual bool isPlayingMusic() { return _bPlayingTrack; }
 	virtual bool isActuallyPlayingMusic() { return Mix_PlayingMusic() == 1; }
 
-    virtual int addSfx(const std::string &filename, unsigned int reqPos);
+    virtual int addSfx(const std::string &filename, unsigned int reqPos, eSfxPriority pri = SFX_PRI_NORMAL);
 	virtual void playSfx(unsigned int iSnd, unsigned int count = 0);
 	virtual void playSfx(const std::string &sound, unsigned int count = 0);
 
@@ -134,6 +138,9 @@ protected:
 	void loadTracks(const std::string &baseDir);
 	std::string getNextTrack();
 	std::string getPrevTrack();
+	void allocateChannels();
+	int  channelFor(eSfxPriority pri);
+	static void postMix(void *udata, Uint8 *stream, int len);
 
 #ifdef _USE_MIKMOD
 //public:
@@ -154,16 +161,27 @@ protected:
 	Mix_Music 	            *_musicTrack;
 	int			            _lastTrack;
 	std::string             _baseTrackDir;
-	std::deque<std::string> _trackList;
+	TrackLibrary            _tracks;
 	bool		            _bPlayingTrack;		//set true if start playing
 
     AudioOptions            _opt;
     Sint16		            _sfxVolSave, _musicVolSave;  //vol prev to mute
 
-    //sound effects list
-    // maybe store the filename too for simpler but slower lookup
-    // so would need to have vect of struct { string, Mix_Chunk };
-    std::vector<Mix_Chunk *> _sfxList;
+    //sound effects list, by AUDIO_SFX_ id. Ids using the same file share one
+    //chunk, already converted to the device format by Mix_LoadWAV
+    struct SSfx
+    {
+        std::string     name;
+        Mix_Chunk *     chunk;
+        eSfxPriority    pri;
+    };
+    std::vector<SSfx>       _sfxList;
+
+    //device as actually opened, and the mixer callback as measured
+    int                     _bufferSamples;     //asked for, 0 = SOUND_CHUNK
+    int                     _freq, _channels;
+    Uint16                  _format;
+    std::atomic<Uint32>     _mixCalls, _mixBytes, _mixFirst, _mixLast;
 };
 
 #endif //_AUDIO_H
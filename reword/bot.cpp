@@ -0,0 +1,88 @@
+////////////////////////////////////////////////////////////////////
+/*
+
+File:			bot.cpp
+
+Class impl:		BotInput
+
+Description:	Scripted input that plays the game. When a new target word
+				appears it takes the level's word list from Words and decides
+				which words it 'finds' (each with a skill% chance) and when
+				(a random think time per word), then types them on the keyboard
+				so they go through the roundels and try word (X/Return) just
+				as a player's would.
+				Between levels, and once out of words, it presses Return every
+				so often, which moves on past the level end, and from the menus
+				(or high score entry) back into a new game after a game over.
+
+Licence:		This program is free software; you can redistribute it and/or modify
+				it under the terms of the GNU General Public License as published by
+				the Free Software Foundation; either version 2 of the License, or
+				(at your option) any later version.
+
+				This software is distributed in the hope that it will be useful,
+				but WITHOUT ANY WARRANTY; without even the implied warranty of
+				MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+				GNU General Public License for more details.
+
+				You should have received a copy of the GNU General Public License
+				along with this program; if not, write to the Free Software
+				Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+////////////////////////////////////////////////////////////////////
+
+#include "bot.h"
+#include "locator.h"
+
+#include <algorithm>
+#include <iostream>
+
+#define BOT_START_MS	1200	//wait for the letters to slide in
+#define BOT_NUDGE_MS	1000	//Return this often when idle
+
+BotInput::BotInput(unsigned int skill, Uint32 thinkMs) :
+	_skill(std::min(skill, 100u)), _thinkMs(thinkMs), _rnd(5489u), _nudge(0)
+{
+	std::cout << "Bot playing, skill " << _skill << "%, " << _thinkMs << "ms a word" << std::endl;
+}
+
+void BotInput::plan(const std::string &target, Uint32 now)
+{
+	std::vector<std::string> words;
+	for (auto &it : Locator::data()._words.getWordsInTarget())
+		if (_rnd.below(100) < _skill)
+			words.push_back(it.first);
+	std::shuffle(words.begin(), words.end(), _rnd);
+
+	//a full length word first, as a player would hunt for, if it found one
+	auto full = std::find_if(words.begin(), words.end(),
+		[&target](const std::string &w) { return w.length() == target.length(); });
+	if (full != words.end())
+		std::iter_swap(words.begin(), full);
+
+	_queued.clear();
+	Uint32 when = now + BOT_START_MS;
+	for (auto &w : words)
+		when = queueWord(w, when + _thinkMs / 2 + _rnd.below(_thinkMs + 1));	//half to one and a half times
+	_nudge = when + BOT_NUDGE_MS;
+}
+
+void BotInput::feed(Uint32 now)
+{
+	//a new target word means a new level, so work out how to play it
+	const std::string target = Locator::data()._words.getWordTarget();
+	if (target != _target)
+	{
+		_target = target;
+		if (!target.empty())
+			plan(target, now);
+	}
+
+	if (_queued.empty() && now >= _nudge)
+	{
+		queueKey(SDLK_RETURN, now);
+		_nudge = now + BOT_NUDGE_MS;
+	}
+	pushDue(now);
+}
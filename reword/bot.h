@@ -0,0 +1,30 @@
+//bot.h
+//
+//A player for headless load testing (reword -bot). Plays whatever mode the
+//mode menu starts on, finding a share of each level's words.
+
+#if !defined BOT_H
+#define BOT_H
+
+#include "headless.h"
+#include "random.h"
+
+class BotInput : public ScriptInput
+{
+public:
+	BotInput(unsigned int skill, Uint32 thinkMs);
+
+	virtual void feed(Uint32 now);
+	virtual bool finished() const { return false; }	//plays until enough levels done
+
+private:
+	void plan(const std::string &target, Uint32 now);
+
+	unsigned int	_skill;		//0..100, chance of finding each word
+	Uint32			_thinkMs;	//average time to spot a word before typing it
+	Rng				_rnd;		//fixed seed, so runs over the same words are repeatable
+	std::string		_target;	//level being played
+	Uint32			_nudge;		//next time to press Return when idle
+};
+
+#endif //BOT_H
@@ -31,6 +31,7 @@ Licence:		This program is free software; you can redistribute it and/or modify
 
 #include "global.h"
 #include "button.h"
+#include "locator.h"
 
 
 Button::Button() : 
@@ -48,7 +49,7 @@ void Button::up()
 //set button state down, and prepare repeat rate
 void Button::down()
 {
-	_last_pressed = SDL_GetTicks();
+	_last_pressed = Locator::clock().now();
 	_pressed = true;
 }
 
@@ -61,9 +62,9 @@ bool Button::isPressed() const
 //return true if a rate is set, and button pressed and rate interval has expired since last test
 bool Button::repeat()
 {
-	if (_rate && _pressed && (SDL_GetTicks() - _last_pressed) > _repeat)
+	if (_rate && _pressed && (Locator::clock().now() - _last_pressed) > _repeat)
 	{
-		_last_pressed = SDL_GetTicks();
+		_last_pressed = Locator::clock().now();
 		_repeat = _rate;
 		return true;
 	}
@@ -0,0 +1,88 @@
+////////////////////////////////////////////////////////////////////
+/*
+
+File:			clock.cpp
+
+Class impl:		Clock
+
+Description:	Game time used in place of SDL_GetTicks() by the frame rate,
+				timers, easing, waiting and button repeat code. Sampled once a
+				frame by Game::play() (and on entering each screen), so a frame
+				can't see more than one 'now', and scaled or held still there
+				when paused. In virtual mode the source only moves when
+				advance() is called, once per frame by the headless game loop.
+
+Licence:		This program is free software; you can redistribute it and/or modify
+				it under the terms of the GNU General Public License as published by
+				the Free Software Foundation; either version 2 of the License, or
+				(at your option) any later version.
+
+				This software is distributed in the hope that it will be useful,
+				but WITHOUT ANY WARRANTY; without even the implied warranty of
+				MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+				GNU General Public License for more details.
+
+				You should have received a copy of the GNU General Public License
+				along with this program; if not, write to the Free Software
+				Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+////////////////////////////////////////////////////////////////////
+
+#include "clock.h"
+
+Clock::Clock() :
+	_bVirtual(false), _virtualTicks(0), _last(SDL_GetTicks()), _now(1),
+	_part(0), _bPaused(false), _scale(1)
+{
+}
+
+Uint32 Clock::source() const
+{
+	return _bVirtual ? _virtualTicks : SDL_GetTicks();
+}
+
+Uint32 Clock::stamp()
+{
+	const Uint32 src = source();
+	const Uint32 elapsed = src - _last;
+	_last = src;
+	if (!_bPaused)
+	{
+		if (1 == _scale)
+			_now += elapsed;
+		else
+		{
+			_part += elapsed * _scale;
+			const Uint32 ms = (Uint32)_part;
+			_part -= ms;
+			_now += ms;
+		}
+	}
+	return _now;
+}
+
+void Clock::setVirtual(bool bVirtual)
+{
+	if (bVirtual && !_bVirtual)
+		_virtualTicks = SDL_GetTicks();	//carry on from now
+	_bVirtual = bVirtual;
+	_last = source();
+}
+
+void Clock::advance(Uint32 ms)
+{
+	if (_bVirtual)
+		_virtualTicks += ms;
+}
+
+//stamps while paused leave game time where it is
+void Clock::pause(bool bPause)
+{
+	_bPaused = bPause;
+}
+
+void Clock::setScale(float scale)
+{
+	_scale = (scale > 0) ? scale : 1;
+}
@@ -0,0 +1,42 @@
+//clock.h
+//
+//Game time in ms, registered with the Locator. The game loop stamps it once
+//at the start of each frame so everything in that frame sees the same now().
+//Game time can be paused or run faster/slower than its source, which is
+//SDL_GetTicks() or, for headless runs, a virtual clock that only moves when
+//advance() is called.
+
+#if !defined CLOCK_H
+#define CLOCK_H
+
+#include <SDL.h>
+
+class Clock
+{
+public:
+	Clock();
+
+	Uint32	now() const { return _now; }	//game time at the last stamp, never 0 (see Easing)
+	Uint32	stamp();						//move game time on by the source time since the last stamp
+	Uint32	source() const;					//source time read now, not paused or scaled
+
+	void	setVirtual(bool bVirtual);		//starts from the current source time
+	bool	isVirtual() const { return _bVirtual; }
+	void	advance(Uint32 ms);				//virtual source only
+
+	void	pause(bool bPause);
+	bool	isPaused() const { return _bPaused; }
+	void	setScale(float scale);			//game ms per source ms, 1 is normal speed
+	float	scale() const { return _scale; }
+
+private:
+	bool	_bVirtual;
+	Uint32	_virtualTicks;
+	Uint32	_last;		//source time of the last stamp
+	Uint32	_now;
+	float	_part;		//part ms carried over when scaled
+	bool	_bPaused;
+	float	_scale;
+};
+
+#endif //CLOCK_H
@@ -34,27 +34,47 @@ Licence:		This program is free software; you can redistribute it and/or modify
 ////////////////////////////////////////////////////////////////////
 
 #include "controls.h"
+#include "screen.h"
 
-Controls::Controls()
+#include <algorithm>
+
+//same area as Sprite::contains(), empty if no sprite
+static SDL_Rect touchArea(Sprite *ps)
+{
+    SDL_Rect r = { 0, 0, 0, 0 };
+    if (ps)
+    {
+        r.x = (int)ps->getXPos();
+        r.y = (int)ps->getYPos();
+        r.w = (int)ps->tileW();
+        r.h = (int)ps->tileH();
+    }
+    return r;
+}
+
+Controls::Controls() :
+    _gridW(0), _gridH(0), _bGridDirty(true)
 {
-    //ctor
+    std::fill(_index, _index + CTRLID_MAX, -1);
 }
 
 int Controls::add(Control &ctrl)
 {
+    const int id = ctrl.getControlId();
+    assert(id > 0 && id < CTRLID_MAX);
+    if (id > 0 && id < CTRLID_MAX && _index[id] < 0)
+        _index[id] = (int)_controls.size();     //first one added wins, as the old search did
     _controls.push_back(ctrl);
+    _bGridDirty = true;
     return (int)_controls.size();
 }
 
 Control * Controls::getControl(int id)
 {
     //find the control matchng the id and return a ptr to it
-    t_controls::iterator it = _controls.begin();
-    t_controls::iterator end = _controls.end();
-    for ( ; it != end; ++it)
+    if (id > 0 && id < CTRLID_MAX && _index[id] >= 0)
     {
-        if (it->getControlId() == id)
-            return &(*it);
+        return &_controls[_index[id]];
     }
 	std::cerr << "Controls::getControl(" << id << ") failed to find " << std::endl;
     assert(0);
@@ -85,11 +105,16 @@ void Controls::render(Screen* s)
 // other processing
 void Controls::work(Input* input, float speedFactor)
 {
-    t_controls::iterator it = _controls.begin();
-    t_controls::iterator end = _controls.end();
-    for ( ; it != end; ++it)
+    for (int i = 0; i < (int)_controls.size(); ++i)
     {
-        it->work(input, speedFactor);
+        _controls[i].work(input, speedFactor);
+        if (!_bGridDirty)
+        {
+            //only rebuilt once one has actually moved (sliding in, or moved by the screen)
+            const SDL_Rect r = touchArea(_controls[i].getSprite());
+            const SDL_Rect &was = _gridAreas[i];
+            _bGridDirty = (r.x != was.x || r.y != was.y || r.w != was.w || r.h != was.h);
+        }
     }
 }
 // notification of button/input state change
@@ -98,21 +123,67 @@ bool Controls::button(Input* /*input*/, ppkey::eButtonType /*b*/)
     return false;
 }
 
+//put each control into every grid square its touch area overlaps
+void Controls::buildGrid()
+{
+    _gridW = (Screen::width() + GRID_CELL - 1) / GRID_CELL;
+    _gridH = (Screen::height() + GRID_CELL - 1) / GRID_CELL;
+    _grid.resize(_gridW * _gridH);
+    for (auto &cell : _grid) cell.clear();     //keeps capacity
+    _gridAreas.resize(_controls.size());
+
+    for (int i = 0; i < (int)_controls.size(); ++i)
+    {
+        const SDL_Rect r = _gridAreas[i] = touchArea(_controls[i].getSprite());
+        if (!_controls[i].getSprite()) continue;
+        const int x0 = std::max(0, r.x / GRID_CELL);
+        const int y0 = std::max(0, r.y / GRID_CELL);
+        const int x1 = std::min(_gridW - 1, (r.x + r.w - 1) / GRID_CELL);
+        const int y1 = std::min(_gridH - 1, (r.y + r.h - 1) / GRID_CELL);
+        for (int gy = y0; gy <= y1; ++gy)
+            for (int gx = x0; gx <= x1; ++gx)
+                _grid[gy * _gridW + gx].push_back(i);
+    }
+    _bGridDirty = false;
+}
+
+//controls that need to see a touch or tap at pt, in _controls order: those
+//that could contain it, and any still pressed (as they fade when missed)
+void Controls::hitCandidates(const Point &pt)
+{
+    if (_bGridDirty) buildGrid();
+
+    _hits.clear();
+    if (pt.x < 0 || pt.y < 0 || pt.x >= _gridW * GRID_CELL || pt.y >= _gridH * GRID_CELL)
+    {
+        for (int i = 0; i < (int)_controls.size(); ++i) _hits.push_back(i);   //off the grid
+        return;
+    }
+    const std::vector<int> &cell = _grid[(pt.y / GRID_CELL) * _gridW + pt.x / GRID_CELL];
+    _hits.insert(_hits.end(), cell.begin(), cell.end());
+    _hits.insert(_hits.end(), _pressed.begin(), _pressed.end());
+    std::sort(_hits.begin(), _hits.end());
+    _hits.erase(std::unique(_hits.begin(), _hits.end()), _hits.end());
+}
+
 // screen touch (press) of one of the controls?
 int Controls::touched(const Point &pt)
 {
     int id(0);
-    t_controls::iterator it = _controls.begin();
-    t_controls::iterator end = _controls.end();
-    for ( ; it != end; ++it)
+    hitCandidates(pt);
+    for (auto i : _hits)
     {
-        if (it->touch(pt))  //changes matched control to 'selected' frame
+        if (_controls[i].touch(pt))  //changes matched control to 'selected' frame
         {
             //save id of the control pressed to pass back
-            id = it->getControlId();
+            id = _controls[i].getControlId();
             //loop to end - so each control gets a touch() call
         }
     }
+
+    _pressed.clear();
+    for (auto i : _hits)
+        if (_controls[i].isPressed()) _pressed.push_back(i);
     return id;
 }
 
@@ -120,17 +191,20 @@ int Controls::touched(const Point &pt)
 int Controls::tapped(const Point &pt)
 {
     int id(0);
-    t_controls::iterator it = _controls.begin();
-    t_controls::iterator end = _controls.end();
-    for ( ; it != end; ++it)
+    hitCandidates(pt);
+    for (auto i : _hits)
     {
-        if (it->tap(pt))
+        if (_controls[i].tap(pt))
         {
             //save id of the control pressed to pass back
-            id = it->getControlId();
+            id = _controls[i].getControlId();
             //loop to end - so each control gets a tap() call
         }
     }
+
+    _pressed.clear();
+    for (auto i : _hits)
+        if (_controls[i].isPressed()) _pressed.push_back(i);
     return id;
 }
 
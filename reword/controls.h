@@ -44,8 +44,23 @@ public:
 	int tapped(const Point &pt);
 
 protected:
+    enum { GRID_CELL = 64 };    //hit test grid square size, px
+
+    void hitCandidates(const Point &pt);
+    void buildGrid();
 
     t_controls  _controls;
+    int         _index[CTRLID_MAX]; //_controls position of each id, -1 if none
+
+    //touch hit testing. Screen split into GRID_CELL squares, each listing the
+    //controls overlapping it. Rebuilt on the next touch after work() sees a
+    //control has moved (or one is added)
+    std::vector<std::vector<int> >  _grid;
+    std::vector<SDL_Rect>   _gridAreas; //each control's area when the grid was built
+    int         _gridW, _gridH;
+    bool        _bGridDirty;
+    std::vector<int>    _pressed;   //controls left pressed by a touch, to fade
+    std::vector<int>    _hits;      //controls to pass a touch or tap to
 };
 
 #endif // CONTROLS_H
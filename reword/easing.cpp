@@ -5,9 +5,10 @@ File:			easing.cpp
 
 Class impl:		Easing
 
-Description:	A class to implement different easing functions for use in the Sprite
-                class or other objects.
-                Simply wraps the easing functions taken from JQuery.
+Description:	The tweens for every eased Sprite move, worked together once a
+                frame in arrays grouped by curve.
+                The easing functions taken from JQuery, normalised to 0..1 so
+                each is a plain function of t/d (see curve()).
 
 Author:			Al McLuckie (al-at-purplepup-dot-org)
 
@@ -35,110 +36,215 @@ Licence:		This program is free software; you can redistribute it and/or modify
 ////////////////////////////////////////////////////////////////////
 
 #include "easing.h"
+#include "locator.h"
 
 #include <SDL.h>
 
-#include <cassert>
+#include <algorithm>
 #include <cmath>
 
 
 #define PI 3.14159265f
 
-Easing::Easing() : _prevTicks(0), _pEasingFn(0)
+//The curves, each for x = 0..1 (t/d) with b = 0 and c = 1, so one tween is
+//just b + c * curve(t/d)
+
+static inline float curveLinear(float x)
 {
-    //ctor
+    return x;
 }
 
-
-//quick setup
-void Easing::setup(eType ease, float time, float begin, float change, float duration, float s/*=0*/)
+static inline float curveOutBounce(float x)
 {
-    switch (ease)
-    {
-        case EASE_OUTBOUNCE: _pEasingFn = &Easing::easeOutBounce; break;
-        case EASE_INOUTSINE: _pEasingFn = &Easing::easeInOutSine; break;
-        case EASE_OUTQUART: _pEasingFn = &Easing::easeOutQuart; break;
-        case EASE_OUTELASTIC: _pEasingFn = &Easing::easeOutElastic; break;
-
-        //else always linear
-        case EASE_LINEAR:
-        default:
-            _pEasingFn = &Easing::easeLinear;
-            break;
-    }
-
-    _ease.t = time;
-    _ease.b = begin;
-    _ease.c = change;
-    _ease.d = duration;
-    _ease.s = s;    //curr unused
-    _ease.bDone = false;
-
-    _prevTicks = 0;
+    //four bounces, each a parabola 7.5625(x-m)^2 + h
+    const float m = (x < 1/2.75f) ? 0 : (x < 2/2.75f) ? 1.5f/2.75f : (x < 2.5f/2.75f) ? 2.25f/2.75f : 2.625f/2.75f;
+    const float h = (x < 1/2.75f) ? 0 : (x < 2/2.75f) ? .75f : (x < 2.5f/2.75f) ? .9375f : .984375f;
+    x -= m;
+    return 7.5625f*x*x + h;
 }
 
-float Easing::work()
+//smoother, almost linear
+static inline float curveInOutSine(float x)
 {
-    if (_ease.bDone) return 0;
-
-    assert(_pEasingFn);
-    float r = (*this.*_pEasingFn)(_ease);
-
-    const Uint32 ticks = SDL_GetTicks();
-    if (!_prevTicks)
-        _prevTicks = ticks;
-    _ease.t += ticks - _prevTicks;
-    _prevTicks = ticks;
-
-    if (_ease.t >= _ease.d) _ease.bDone = true;
+    return -0.5f * (std::cos(PI*x) - 1);
+}
 
-    return r;
+static inline float curveOutQuart(float x)
+{
+    x -= 1;
+    return 1 - x*x*x*x;
 }
 
-float Easing::easeLinear(Ease e)
+//period .3 of the duration, phase shift a quarter of that
+static inline float curveOutElastic(float x)
 {
-    return (e.c*e.t/e.d) + e.b;
+    if (x <= 0) return 0;
+    if (x >= 1) return 1;
+    return std::pow(2.0f, -10*x) * std::sin((x - .075f) * (2*PI) / .3f) + 1;
 }
 
-float Easing::easeOutBounce(Ease e)
+//t/d kept to the curve, so a tween still waiting on its delay (t < 0) sits at
+//its start, and a 0 duration is straight to the end
+static inline float easeX(float t, float d)
 {
-//Where t: time, b: begining position, c: total change in position, d: duration.
-
-    if ((e.t/=e.d) < (1/2.75f)) {
-        return e.c* (7.5625f*e.t*e.t) + e.b;
-    } else if (e.t < (2 / 2.75f)) {
-        return e.c* (7.5625f*(e.t-=(1.5f/ 2.75f))*e.t + .75f) + e.b;
-    } else if (e.t < (2.5f/2.75f)) {
-        return e.c* (7.5625f*(e.t-=(2.25f/2.75f))*e.t + .9375f) + e.b;
-    } else {
-        return e.c* (7.5625f*(e.t-=(2.625f/2.75f))*e.t + .984375f) + e.b;
-    }
+    if (d <= 0) return (t < 0) ? 0.0f : 1.0f;
+    return std::max(std::min(t / d, 1.0f), 0.0f);
 }
 
-//smoother, almost linear
-float Easing::easeInOutSine(Ease e)
+//all the tweens on one curve. The curve is inlined, so nothing is looked up
+//or called per tween
+template<float (*CURVE)(float)>
+static void tickCurve(size_t n, float dt, float *t, const float *b, const float *c, const float *d, float *v)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        t[i] += dt;
+        v[i] = b[i] + c[i] * CURVE(easeX(t[i], d[i]));
+    }
+}
+
+typedef void (*tTickCurve)(size_t, float, float *, const float *, const float *, const float *, float *);
+static const tTickCurve s_tickCurve[Easing::EASE_MAX] =
+{
+    tickCurve<curveLinear>,         //EASE_LINEAR
+    tickCurve<curveOutBounce>,      //EASE_OUTBOUNCE
+    tickCurve<curveInOutSine>,      //EASE_INOUTSINE
+    tickCurve<curveOutQuart>,       //EASE_OUTQUART
+    tickCurve<curveOutElastic>      //EASE_OUTELASTIC
+};
+
+Easing::Easing() : _now(0)
 {
-    return -e.c/2 * (cos(PI*e.t/e.d) - 1) + e.b;
+    //ctor
+}
+
+Easing::tEaseId Easing::add(eType ease, float begin, float change, float duration, Uint32 delay /*= 0*/)
+{
+    if (ease < 0 || ease >= EASE_MAX) ease = EASE_LINEAR;
+
+    //the next tick moves it on by the time since the last one, which can be
+    //well before now (while a screen loads), so start it that much earlier
+    const Uint32 now = Locator::clock().now();
+    if (!_now) _now = now;
+    const float t = (float)(Sint32)(_now - now) - (float)delay;
+    return insert(ease, t, begin, change, duration, begin);
 }
 
-float Easing::easeOutQuart(Ease e)
+Easing::tEaseId Easing::copy(tEaseId id)
 {
-    return -e.c * ((e.t=e.t/e.d-1)*e.t*e.t*e.t - 1) + e.b;
+    const SSlot *s = slot(id);
+    if (!s) return 0;
+    const SCurve &k = _curves[s->curve];
+    const size_t i = s->index;
+    return insert(s->curve, k.t[i], k.b[i], k.c[i], k.d[i], k.v[i]);
+}
+
+Easing::tEaseId Easing::insert(int curve, float t, float b, float c, float d, float v)
+{
+    tEaseId id;
+    if (!_free.empty())
+    {
+        id = _free.back();
+        _free.pop_back();
+    }
+    else
+    {
+        _slots.push_back(SSlot());
+        id = (tEaseId)_slots.size();
+    }
+
+    SCurve &k = _curves[curve];
+    _slots[id - 1].curve = curve;
+    _slots[id - 1].index = k.id.size();
+    k.t.push_back(t);
+    k.b.push_back(b);
+    k.c.push_back(c);
+    k.d.push_back(d);
+    k.v.push_back(v);
+    k.id.push_back(id);
+    return id;
+}
+
+//the last tween on the curve moves into the gap, so the arrays stay packed
+void Easing::release(tEaseId id)
+{
+    const SSlot *s = slot(id);
+    if (!s) return;
+    SCurve &k = _curves[s->curve];
+    const size_t i = s->index, last = k.id.size() - 1;
+
+    k.t[i] = k.t[last];
+    k.b[i] = k.b[last];
+    k.c[i] = k.c[last];
+    k.d[i] = k.d[last];
+    k.v[i] = k.v[last];
+    k.id[i] = k.id[last];
+    _slots[k.id[i] - 1].index = i;
+
+    k.t.pop_back();
+    k.b.pop_back();
+    k.c.pop_back();
+    k.d.pop_back();
+    k.v.pop_back();
+    k.id.pop_back();
+
+    _slots[id - 1].curve = -1;
+    _free.push_back(id);
+}
+
+const Easing::SSlot *Easing::slot(tEaseId id) const
+{
+    if (id == 0 || id > _slots.size() || _slots[id - 1].curve < 0)
+        return nullptr;
+    return &_slots[id - 1];
+}
+
+float Easing::value(tEaseId id) const
+{
+    const SSlot *s = slot(id);
+    return s ? _curves[s->curve].v[s->index] : 0;
+}
+
+bool Easing::done(tEaseId id) const
+{
+    const SSlot *s = slot(id);
+    return !s || _curves[s->curve].t[s->index] >= _curves[s->curve].d[s->index];
+}
+
+void Easing::tick(Uint32 now)
+{
+    const float dt = (float)(Sint32)(now - _now);
+    _now = now;
+    for (int curve = 0; curve < EASE_MAX; ++curve)
+    {
+        SCurve &k = _curves[curve];
+        if (!k.id.empty())
+            s_tickCurve[curve](k.id.size(), dt, &k.t[0], &k.b[0], &k.c[0], &k.d[0], &k.v[0]);
+    }
+}
+
+void Easing::clear()
+{
+    for (auto &k : _curves)
+        k = SCurve();
+    _slots.clear();
+    _free.clear();
 }
 
-float Easing::easeOutElastic(Ease e)
+float Easing::curve(eType ease, float x)
 {
-    e.s=1.70158f;
-    float p=0;
-    float a=e.c;
-    if (e.t==0) return e.b;
-    if ((e.t/=e.d)==1) return e.b+e.c;
-    if (!p) p=e.d*.3f;
-    if (a < abs(e.c))
-        { a=e.c; e.s=p/4; }
-    else
-        e.s = p/(2*PI) * asin(e.c/a);
-    return a*(float)pow(2,-10*e.t) * sin( (e.t*e.d-e.s)*(2*PI)/p ) + e.c + e.b;
+    switch (ease)
+    {
+        case EASE_OUTBOUNCE: return curveOutBounce(x);
+        case EASE_INOUTSINE: return curveInOutSine(x);
+        case EASE_OUTQUART: return curveOutQuart(x);
+        case EASE_OUTELASTIC: return curveOutElastic(x);
+
+        //else always linear
+        case EASE_LINEAR:
+        default:
+            return curveLinear(x);
+    }
 }
 
 
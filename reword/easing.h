@@ -1,44 +1,59 @@
+//easing.h
+//
+//Every eased sprite move in one place, registered with the Locator. A sprite
+//adds a tween for each axis it moves on and reads its value back. The game
+//loop ticks them all once a frame, before the screens work(), on the game
+//Clock. The tweens are kept in contiguous arrays, a set for each curve, so a
+//tick is one tight loop per curve rather than a call per sprite.
+
 #if !defined EASING_H
 #define EASING_H
 
 #include <SDL.h>
 
-
-struct Ease
-{
-    Ease() : t(0), b(0), c(0), d(0), s(0), bDone(false) {}
-    float t;  //time ms (usually 0)
-    float b;  //start pos
-    float c;  //total change? ie start pos + dist to end pos
-    float d;  //duration ms
-    float s;
-    bool bDone;
-};
+#include <vector>
 
 class Easing
 {
 public:
-    enum eType { EASE_LINEAR, EASE_OUTBOUNCE, EASE_INOUTSINE, EASE_OUTQUART, EASE_OUTELASTIC };
+    enum eType { EASE_LINEAR, EASE_OUTBOUNCE, EASE_INOUTSINE, EASE_OUTQUART, EASE_OUTELASTIC, EASE_MAX };
+    typedef Uint32 tEaseId;     //0 is never a valid id
 
     Easing();
-    void setup(eType ease, float time, float begin, float change, float duration, float s=0.0);
-    float work();
-    bool done() const { return _ease.bDone; }
 
-    //all easing functions are public to allow calling without helper functions above
-    float easeLinear(Ease e);
-    float easeOutBounce(Ease e);
-    float easeInOutSine(Ease e);
-    float easeOutQuart(Ease e);
-    float easeOutElastic(Ease e);
+    //from begin to begin+change over duration ms, starting delay ms from now
+    tEaseId add(eType ease, float begin, float change, float duration, Uint32 delay = 0);
+    tEaseId copy(tEaseId id);           //a separate tween where this one is now, 0 for 0
+    void    release(tEaseId id);        //ok to call with 0
+    float   value(tEaseId id) const;    //as of the last tick
+    bool    done(tEaseId id) const;     //reached the end, always true for 0
+    void    tick(Uint32 now);           //move every tween on to game time now
+    void    clear();
+    size_t  size() const { return _slots.size() - _free.size(); }
 
+    //curve at x = t/d, 0 at the start to 1 at the end (elastic and bounce overshoot)
+    static float curve(eType ease, float x);
 
 private:
-
-    Ease    _ease;
-    Uint32  _prevTicks;
-
-    float (Easing::*_pEasingFn)(Ease);
+    struct SCurve               //one entry per tween on this curve, in the same order
+    {
+        std::vector<float>      t, b, c, d;     //time so far, begin, change and duration
+        std::vector<float>      v;              //value at the last tick
+        std::vector<tEaseId>    id;
+    };
+    struct SSlot
+    {
+        int     curve;          //-1 when free
+        size_t  index;          //into that curves arrays
+    };
+
+    tEaseId insert(int curve, float t, float b, float c, float d, float v);
+    const SSlot *slot(tEaseId id) const;
+
+    SCurve  _curves[EASE_MAX];
+    std::vector<SSlot>      _slots;     //by id - 1
+    std::vector<tEaseId>    _free;
+    Uint32  _now;               //time of the last tick
 };
 
 #endif // EASING_H
@@ -36,14 +36,42 @@ Licence:		This program is free software; you can redistribute it and/or modify
 #include "global.h"
 #include "platform.h"
 #include "fontttf.h"
+#include "resource.h"
 
 #include <iostream>
 #include <assert.h>
 #include <memory>
+#include <algorithm>
+#include <cstring>
 
 #include "./tinyxml/tinyxml.h"
 
 #define XMIDPOSITION    (-999)
+#define GLYPH_PAD       1       //transparent pixels between glyphs in the atlas (no bleed when scaled)
+
+//decode the next utf8 code point and move pos past it. Any byte that isn't part of
+//a valid utf8 sequence is returned as is, so plain 8 bit strings still map to 0..255
+static Uint32 utf8Next(const char *&pos)
+{
+    const Uint8 *p = reinterpret_cast<const Uint8 *>(pos);
+    Uint32 ch = p[0];
+    int extra = 0;
+    if ((ch & 0xE0) == 0xC0)        { ch &= 0x1F; extra = 1; }
+    else if ((ch & 0xF0) == 0xE0)   { ch &= 0x0F; extra = 2; }
+    else if ((ch & 0xF8) == 0xF0)   { ch &= 0x07; extra = 3; }
+
+    for (int i = 1; i <= extra; ++i)
+    {
+        if ((p[i] & 0xC0) != 0x80)
+        {
+            ++pos;          //not a continuation byte, so not utf8
+            return p[0];
+        }
+        ch = (ch << 6) | (p[i] & 0x3F);
+    }
+    pos += 1 + extra;
+    return ch;
+}
 
 FontTTF::FontTTF() :
     _font(nullptr), _size(0), _init(false), _height(0),
@@ -74,6 +102,9 @@ void FontTTF::cleanUp()
     _height = 0;
     _bFastBMP = _bFastTTF = false;
     _fastTex.reset();
+    _fastWidths.clear();
+    _fastWidthsExt.clear();
+    _kerning.clear();
 	_init = false;
 }
 
@@ -103,72 +134,235 @@ bool FontTTF::loadTTF(const std::string &fileName, int fontSize, const std::stri
 
 	_init = (_font != nullptr);
 
-//	if (_init)
-//        convertToFastTexture();
+	if (_init)
+        convertToFastTexture();
 
 	return _init;
 }
 
+//build a glyph atlas from the loaded TTF font. Each glyph is rendered on its own,
+//cropped to its inked pixels and shelf packed into a 2D texture, with bearing,
+//advance and kerning taken from the font. Means put_text() can blit from _fastTex
+//exactly like the BMP fonts do, rather than rendering whole strings every frame.
 bool FontTTF::convertToFastTexture()
 {
-//    TTF_SetFontHinting(_font, TTF_HINTING_NONE);    //reduces glitching
-    TTF_SetFontHinting(_font, TTF_HINTING_MONO);    //reduces glitching
+    if (nullptr == _font) return false;
+
+    //printable latin-1 plus a few common typographic code points
+    std::vector<Uint16> chars;
+    for (Uint16 ch = 32; ch < 127; ++ch) chars.push_back(ch);
+    for (Uint16 ch = 160; ch < 256; ++ch) chars.push_back(ch);
+    const Uint16 extra[] = { 0x2013, 0x2014, 0x2018, 0x2019, 0x201C, 0x201D, 0x2022, 0x2026, 0x20AC };
+    chars.insert(chars.end(), std::begin(extra), std::end(extra));
 
-    //create a texture containing each char
-    std::string chrs;
-    int prevStart(0);
-    for (int i = 0; i < 255; ++i)
+    _fastWidths.assign(256, SFastWidths{0, 0, 0, 0, 0, 0, 0});
+    _fastWidthsExt.clear();
+    _kerning.clear();
+
+    struct SGlyph
+    {
+        Uint16 ch;
+        SDL_Surface *surf;
+        SDL_Rect box;
+    };
+    std::vector<SGlyph> glyphs;
+    int area(0), widest(0);
+    for (auto ch : chars)
     {
-//        const char c = (i<32 ||     //unprintable below space
-//                         (i==92) || (i==94) || (i==95)  //cause glitches in glyphs
-//                        || i>122)   //more glitches
-//                        ? 'X' : (char)i;  //make duff chars ok, else actual char
-        const char c = (i<32     //unprintable below space
-                         || (i>=33 && i<=47)  //cause glitches in glyphs
-                         || (i>=58 && i<=63)  //cause glitches in glyphs
-                         || (i>=91 && i<=96)  //cause glitches in glyphs
-                         || i>122)   //more glitches
-                        ? '-' : (char)i;  //make duff chars ok, else actual char
-
-        //save for conversion into texture
-        chrs += c;
-
-        //get individual char width and create width and offset for rendering
-        char character[2] = { c, 0x00 };
-
-        int w, h;
-        int result = TTF_SizeText(_font, &character[0], &w, &h);
-
-        const int len = calc_text_length(&character[0]);
-        SFastWidths widths = {prevStart, len, 0, 0, 0, 0, 0};
-        _fastWidths.push_back(widths);
-        prevStart += len;
+        int minx, maxx, miny, maxy, advance;
+        if (!TTF_GlyphIsProvided(_font, ch) ||
+            TTF_GlyphMetrics(_font, ch, &minx, &maxx, &miny, &maxy, &advance) == -1)
+            continue;
+
+        SFastWidths &w = (ch < 256) ? _fastWidths[ch] : _fastWidthsExt[ch];
+        w = SFastWidths{0, 0, 0, 0, 0, 0, advance};
+
+        SDL_Rect box;
+        SDL_Surface *surf = (maxx > minx) ? renderGlyph(ch, box) : nullptr;  //space etc only need advance
+        if (nullptr == surf) continue;
+
+        //rendered surface starts at the leftmost pixel if the bearing is negative
+        w.offsetX = box.x + std::min(minx, 0);
+        w.offsetY = box.y;
+        w.width = box.w;
+        w.height = box.h;
+        glyphs.push_back(SGlyph{ch, surf, box});
+        area += (box.w + GLYPH_PAD) * (box.h + GLYPH_PAD);
+        widest = std::max(widest, box.w + GLYPH_PAD);
     }
 
-    SDL_Surface *text = TTF_RenderText_Blended( _font, &chrs[0], _fontColour );
-    if (text)
-    {
-//        if (XMIDPOSITION == x) x = (s->width() - text->w ) / 2;
-//
-//        if(!bShadow){
-//            r._min = Point(x, y);
-//            r._max = r._min.add(Point(text->w, text->h));
-//        }
+    //shelf pack tallest first, into a power of 2 width roughly square
+    std::sort(glyphs.begin(), glyphs.end(), [](const SGlyph &a, const SGlyph &b) { return a.box.h > b.box.h; });
+    int atlasW = 64;
+    while (atlasW * atlasW < area || atlasW < widest + GLYPH_PAD) atlasW *= 2;
 
-        Surface surface(text);
-        _fastTex = std::unique_ptr<Texture>(new Texture(surface));
+    std::vector<SDL_Point> place(glyphs.size());
+    int x(GLYPH_PAD), y(GLYPH_PAD), shelfH(0);
+    for (size_t i = 0; i < glyphs.size(); ++i)
+    {
+        const SDL_Rect &box = glyphs[i].box;
+        if (x + box.w + GLYPH_PAD > atlasW)
+        {
+            x = GLYPH_PAD;
+            y += shelfH + GLYPH_PAD;
+            shelfH = 0;
+        }
+        place[i].x = x;
+        place[i].y = y;
+        x += box.w + GLYPH_PAD;
+        shelfH = std::max(shelfH, box.h);
+    }
+    const int atlasH = y + shelfH + GLYPH_PAD;
 
-        SDL_FreeSurface(text);
+    Surface atlas;
+    bool bOk = atlas.create(atlasW, atlasH);
+    for (size_t i = 0; i < glyphs.size(); ++i)
+    {
+        const SGlyph &g = glyphs[i];
+        if (bOk)
+        {
+            //straight copy of the glyph pixels, alpha included (no blend into atlas)
+            SDL_SetSurfaceBlendMode(g.surf, SDL_BLENDMODE_NONE);
+            SDL_Rect src = g.box;
+            ppg::blit_surface(g.surf, &src, atlas.surface(), place[i].x, place[i].y);
+
+            SFastWidths &w = (g.ch < 256) ? _fastWidths[g.ch] : _fastWidthsExt[g.ch];
+            w.startX = place[i].x;
+            w.startY = place[i].y;
+        }
+        SDL_FreeSurface(g.surf);
     }
+    if (!bOk)
+    {
+        std::cerr << "Failed to create glyph atlas (" << atlasW << "x" << atlasH << ") for font " << _fileName << std::endl;
+        _fastWidths.clear();
+        _fastWidthsExt.clear();
+        return false;
+    }
+
+    //kerning pairs are looked up from the font as they're first drawn (see kerning())
+
+    _fastTex = std::unique_ptr<Texture>(new Texture(atlas));
+    _lineHeight = _height;
+
+#ifdef DEBUG
+    std::cout << "Font atlas " << _fileName << " size:" << _size << " glyphs:" << glyphs.size() <<
+        " atlas:" << atlasW << "x" << atlasH << std::endl;
+#endif
 
     //set flag to indicate use of in put_text() functions
     return _bFastTTF = true;
 }
 
+//render a single glyph in white (so colour mod tints it when drawn) and find the
+//rectangle containing the inked pixels. box x,y is then the offset from the pen
+//position and top of the line, same as the BMFont xoffset/yoffset values.
+SDL_Surface * FontTTF::renderGlyph(Uint16 ch, SDL_Rect &box)
+{
+    const SDL_Color white = {0xFF, 0xFF, 0xFF, 0xFF};
+    SDL_Surface *text = TTF_RenderGlyph_Blended(_font, ch, white);
+    if (nullptr == text) return nullptr;
+
+    //blended glyphs are always 32bit with alpha, so just scan the alpha
+    int x0(text->w), y0(text->h), x1(-1), y1(-1);
+    SDL_LockSurface(text);
+    for (int y = 0; y < text->h; ++y)
+    {
+        const Uint32 *row = reinterpret_cast<const Uint32 *>(static_cast<const Uint8 *>(text->pixels) + y * text->pitch);
+        for (int x = 0; x < text->w; ++x)
+        {
+            if (row[x] & text->format->Amask)
+            {
+                x0 = std::min(x0, x);
+                x1 = std::max(x1, x);
+                y0 = std::min(y0, y);
+                y1 = std::max(y1, y);
+            }
+        }
+    }
+    SDL_UnlockSurface(text);
+
+    if (x1 < 0)
+    {
+        SDL_FreeSurface(text);  //nothing visible
+        return nullptr;
+    }
+    box.x = x0;
+    box.y = y0;
+    box.w = x1 - x0 + 1;
+    box.h = y1 - y0 + 1;
+    return text;
+}
+
+//glyph info for a code point, or '?' if the font doesn't have it
+const FontTTF::SFastWidths * FontTTF::glyph(Uint32 ch) const
+{
+    if (ch < _fastWidths.size())
+    {
+        const SFastWidths &w = _fastWidths[ch];
+        if (w.advanceX || w.width) return &w;   //else a zeroed slot, not in the font
+    }
+
+    auto it = _fastWidthsExt.find(ch);
+    if (it != _fastWidthsExt.end()) return &it->second;
+
+    return (_fastWidths.size() > '?') ? &_fastWidths['?'] : nullptr;
+}
+
+//x adjustment between two code points, 0 if none. A TTF font's pairs are asked
+//for as they're first drawn and kept, rather than every pair at load
+int FontTTF::kerning(Uint32 prev, Uint32 ch) const
+{
+    if (prev == 0) return 0;
+    const Uint32 pair = (prev << 16) | (ch & 0xFFFF);
+    auto it = _kerning.find(pair);
+    if (it != _kerning.end()) return it->second;
+    if (!_bFastTTF || nullptr == _font || prev > 0xFFFF || ch > 0xFFFF || !TTF_GetFontKerning(_font))
+        return 0;
+    return _kerning[pair] = TTF_GetFontKerningSizeGlyphs(_font, (Uint16)prev, (Uint16)ch);
+}
+
+//width in pixels of text using the fast texture glyph info
+int FontTTF::calc_fast_width(const char *textstr) const
+{
+    int w(0);
+    Uint32 prev(0);
+    const char *pos = textstr;
+    while (*pos)
+    {
+        const Uint32 ch = utf8Next(pos);
+        const SFastWidths *g = glyph(ch);
+        if (nullptr == g) continue;
+        w += kerning(prev, ch) + g->advanceX;
+        prev = ch;
+    }
+    return w;
+}
+
 bool FontTTF::loadBMP(const std::string &fontInfoName, const std::string &desc)
 {
     if (fontInfoName.length() == 0) return false;
 
+    //metrics baked into the asset pack save parsing the xml, otherwise
+    //parse it and hand the results over in case a new pack is being baked
+    if (!loadBakedMetrics(fontInfoName))
+    {
+        if (!parseFontInfo(fontInfoName))
+            return false;
+        bakeMetrics(fontInfoName);
+    }
+
+    //load font image now (also from the pack if baked)
+    Surface surface;
+    surface.load(RES_FONTS + _fileName);
+    _fastTex = std::unique_ptr<Texture>(new Texture(surface));
+
+    return _init = _bFastBMP = true;
+}
+
+//read the AngelCode BMFont .fnt xml file
+bool FontTTF::parseFontInfo(const std::string &fontInfoName)
+{
     std::unique_ptr<TiXmlDocument> doc(new TiXmlDocument(fontInfoName));
     if (!doc->LoadFile())
     {
@@ -213,45 +407,159 @@ bool FontTTF::loadBMP(const std::string &fontInfoName, const std::string &desc)
 
         e = root->FirstChildElement("chars");
 		if (!e) return false;
-        _fastWidths.clear();
-        SFastWidths widths = {0, 0, 0, 0, 0, 0, 0};
-        for (int i = 0; i < 255; ++i)
-        {
-            _fastWidths.push_back(widths);
-        }
+        _fastWidths.assign(256, SFastWidths{0, 0, 0, 0, 0, 0, 0});
+        _fastWidthsExt.clear();
+        _kerning.clear();
         int pos(0), val(0);
         for(TiXmlElement* e1 = e->FirstChildElement("char"); e1 != nullptr; e1 = e1->NextSiblingElement("char"))
         {
             e1->Attribute("id", &pos);
-            if (pos < 0 || pos > 255)
+            if (pos < 0 || pos > 0xFFFF)
             {
                 std::cout << "fontBmp " << _fileName << "(" << _faceName << ") id:" << pos << " invalild" << std::endl;
                 continue;
             }
+            SFastWidths &w = (pos < 256) ? _fastWidths[pos] : _fastWidthsExt[pos];
             e1->Attribute("x", &val);
-            _fastWidths[pos].startX = val;
+            w.startX = val;
             e1->Attribute("y", &val);
-            _fastWidths[pos].startY = val;
+            w.startY = val;
             e1->Attribute("width", &val);
-            _fastWidths[pos].width = val;
+            w.width = val;
             e1->Attribute("height", &val);
-            _fastWidths[pos].height = val;
+            w.height = val;
             e1->Attribute("xoffset", &val);
-            _fastWidths[pos].offsetX = val;
+            w.offsetX = val;
             e1->Attribute("yoffset", &val);
-            _fastWidths[pos].offsetY = val;
+            w.offsetY = val;
             e1->Attribute("xadvance", &val);
-            _fastWidths[pos].advanceX = val;
+            w.advanceX = val;
+
+        }
 
+        //optional <kernings><kerning first="32" second="65" amount="-1"/>...
+        e = root->FirstChildElement("kernings");
+        if (e)
+        {
+            int first(0), second(0), amount(0);
+            for(TiXmlElement* e1 = e->FirstChildElement("kerning"); e1 != nullptr; e1 = e1->NextSiblingElement("kerning"))
+            {
+                e1->Attribute("first", &first);
+                e1->Attribute("second", &second);
+                e1->Attribute("amount", &amount);
+                if (amount != 0 && first > 0 && second > 0)
+                    _kerning[((Uint32)first << 16) | (second & 0xFFFF)] = amount;
+            }
         }
 	}
+    return root != nullptr;
+}
 
-    //load font image now
-    Surface surface;
-    surface.load(RES_FONTS + _fileName);
-    _fastTex = std::unique_ptr<Texture>(new Texture(surface));
+//helpers to read/write the baked metrics, all in native byte order
+//as the pack itself checks it was written on a matching platform
+template<typename T> static void bakePut(std::vector<Uint8> &out, const T &val)
+{
+    const Uint8 *p = reinterpret_cast<const Uint8 *>(&val);
+    out.insert(out.end(), p, p + sizeof(T));
+}
 
-    return _init = _bFastBMP = true;
+template<typename T> static bool bakeGet(const Uint8 *&pos, const Uint8 *end, T &val)
+{
+    if (pos + sizeof(T) > end) return false;
+    memcpy(&val, pos, sizeof(T));
+    pos += sizeof(T);
+    return true;
+}
+
+static void bakePutStr(std::vector<Uint8> &out, const std::string &s)
+{
+    bakePut(out, (Uint32)s.length());
+    out.insert(out.end(), s.begin(), s.end());
+}
+
+static bool bakeGetStr(const Uint8 *&pos, const Uint8 *end, std::string &s)
+{
+    Uint32 len(0);
+    if (!bakeGet(pos, end, len) || pos + len > end) return false;
+    s.assign(reinterpret_cast<const char *>(pos), len);
+    pos += len;
+    return true;
+}
+
+//store the parsed BMFont metrics in the asset pack (only does anything when baking)
+void FontTTF::bakeMetrics(const std::string &fontInfoName)
+{
+    if (!Resource::pack().isRecording()) return;
+
+    std::vector<Uint8> out;
+    bakePutStr(out, _faceName);
+    bakePutStr(out, _fileName);
+    bakePut(out, (Sint32)_size);
+    bakePut(out, (Sint32)_lineHeight);
+    bakePut(out, (Uint32)_fastWidths.size());
+    for (auto &w : _fastWidths)
+        bakePut(out, w);
+    bakePut(out, (Uint32)_fastWidthsExt.size());
+    for (auto &it : _fastWidthsExt)
+    {
+        bakePut(out, it.first);
+        bakePut(out, it.second);
+    }
+    bakePut(out, (Uint32)_kerning.size());
+    for (auto &it : _kerning)
+    {
+        bakePut(out, it.first);
+        bakePut(out, (Sint32)it.second);
+    }
+    Resource::pack().putData(fontInfoName, out);
+}
+
+//restore the metrics from the asset pack, false if not there (or duff)
+bool FontTTF::loadBakedMetrics(const std::string &fontInfoName)
+{
+    const Uint8 *pos(nullptr);
+    Uint32 len(0);
+    if (!Resource::pack().getData(fontInfoName, pos, len))
+        return false;
+    const Uint8 *end = pos + len;
+
+    Sint32 size(0), lineHeight(0);
+    Uint32 count(0);
+    bool bOk = bakeGetStr(pos, end, _faceName) && bakeGetStr(pos, end, _fileName) &&
+        bakeGet(pos, end, size) && bakeGet(pos, end, lineHeight) && bakeGet(pos, end, count);
+
+    _fastWidths.assign(count, SFastWidths{0, 0, 0, 0, 0, 0, 0});
+    for (Uint32 i = 0; bOk && i < count; ++i)
+        bOk = bakeGet(pos, end, _fastWidths[i]);
+
+    _fastWidthsExt.clear();
+    bOk = bOk && bakeGet(pos, end, count);
+    for (Uint32 i = 0; bOk && i < count; ++i)
+    {
+        Uint32 ch(0);
+        SFastWidths w;
+        bOk = bakeGet(pos, end, ch) && bakeGet(pos, end, w);
+        _fastWidthsExt[ch] = w;
+    }
+
+    _kerning.clear();
+    bOk = bOk && bakeGet(pos, end, count);
+    for (Uint32 i = 0; bOk && i < count; ++i)
+    {
+        Uint32 pair(0);
+        Sint32 amount(0);
+        bOk = bakeGet(pos, end, pair) && bakeGet(pos, end, amount);
+        _kerning[pair] = amount;
+    }
+
+    if (!bOk)
+    {
+        std::cerr << "Baked font metrics for " << fontInfoName << " corrupt, using .fnt file" << std::endl;
+        return false;
+    }
+    _size = size;
+    _lineHeight = _height = lineHeight;
+    return true;
 }
 
 //set the font shadow (to something other than the default black)
@@ -268,16 +576,9 @@ Rect FontTTF::calc_text_metrics(const char *textstr, bool bShadow /*= false*/, i
         if (_bFastBMP || _bFastTTF)
         {
             //must calc size ourselves
-            int nextX = xOffset;
-            char * pos = const_cast<char*>(textstr);
-            while (*pos)
-            {
-                nextX += _fastWidths[(*pos)].advanceX;
-                ++pos;
-            }
             r._min.x = xOffset;
             r._min.y = yOffset;
-            r._max.x = xOffset + nextX;
+            r._max.x = xOffset + calc_fast_width(textstr);
             r._max.y = yOffset + _height;
         }
         else
@@ -312,28 +613,27 @@ Rect FontTTF::put_text(Screen *s, int x, int y, const char *textstr, const SDL_C
         SDL_SetTextureColorMod(_fastTex->texture_sdl(), (Uint8)textColour.r, (Uint8)textColour.g, (Uint8)textColour.b);
 
 		if (XMIDPOSITION == x)
-        {
-            int w = 0;
-            char * pos = const_cast<char*>(textstr);
-            while (*pos)
-            {
-                w += _fastWidths[(*pos)].advanceX;
-                ++pos;
-            }
-            x = (s->width() - w ) / 2;
-        }
+            x = (s->width() - calc_fast_width(textstr)) / 2;
+
         int nextX = x;
-        char * pos = const_cast<char*>(textstr);
+        Uint32 prev(0);
+        const char * pos = textstr;
         while (*pos)
         {
-            //blit each char
-            const SFastWidths *w = &_fastWidths[(*pos)];
-            SDL_Rect srcLetter = {w->startX, w->startY, w->width, w->height};
-			s->blit(_fastTex->texture_sdl(), &srcLetter, nextX + w->offsetX, y + w->offsetY);
+            //blit each char (utf8 decoded), nothing to blit for spaces
+            const Uint32 ch = utf8Next(pos);
+            const SFastWidths *w = glyph(ch);
+            if (nullptr == w) continue;
+            nextX += kerning(prev, ch);
+            if (w->width)
+            {
+                SDL_Rect srcLetter = {w->startX, w->startY, w->width, w->height};
+                s->blit(_fastTex->texture_sdl(), &srcLetter, nextX + w->offsetX, y + w->offsetY);
+            }
 			nextX += w->advanceX;
-			++pos;
+			prev = ch;
         }
-        Rect r(x, y, x + nextX, y + _height);
+        Rect r(x, y, nextX, y + _height);
         return r;
     }
 
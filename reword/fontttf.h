@@ -8,6 +8,7 @@
 #include <SDL_ttf.h>	//for TTF_ functions
 #include <map>
 #include <memory>
+#include <vector>
 
 #include <string>
 
@@ -62,6 +63,12 @@ public:
 protected:
 	void cleanUp();
     bool convertToFastTexture();
+    bool parseFontInfo(const std::string &fontInfoName);
+    bool loadBakedMetrics(const std::string &fontInfoName);
+    void bakeMetrics(const std::string &fontInfoName);
+    SDL_Surface * renderGlyph(Uint16 ch, SDL_Rect &box);
+    int kerning(Uint32 prev, Uint32 ch) const;
+    int calc_fast_width(const char *textstr) const;
 
 private:
 	TTF_Font *	_font;
@@ -86,7 +93,11 @@ private:
 	    int offsetY;
 	    int advanceX;
 	};
-	std::vector<SFastWidths> _fastWidths;
+	std::vector<SFastWidths> _fastWidths;           //direct lookup for chars 0..255
+	std::map<Uint32, SFastWidths> _fastWidthsExt;   //utf8 code points above 255
+	mutable std::map<Uint32, int> _kerning;         //(first << 16 | second) -> x adjust. BMP: non zero pairs
+	                                                //only. TTF: each pair as first used, zero or not
+	const SFastWidths * glyph(Uint32 ch) const;
 	int     _fastSize;
 	int     _lineHeight;
 	int     _base;
@@ -31,9 +31,13 @@ Licence:		This program is free software; you can redistribute it and/or modify
 
 #include "global.h"
 #include "framerate.h"
+#include "locator.h"
+
+#include <iomanip>
+#include <iostream>
 
 Framerate::Framerate() :
-	fps_last(SDL_GetTicks()), fps_count(0), fps_current(0)
+	_capFps(MAXIMUM_FRAME_RATE), fps_last(Locator::clock().now()), fps_count(0), fps_current(0)
 {
 }
 
@@ -41,13 +45,14 @@ Framerate::Framerate() :
 void Framerate::init(float targetFps)
 {
 	_targetFps = targetFps;
-	_frameDelay = SDL_GetTicks();
-	_ticksPerSecond = SDL_GetTicks();
+	_frameDelay = Locator::clock().now();
+	_ticksPerSecond = Locator::clock().now();
 }
 
 void Framerate::setSpeedFactor()
 {
-	_currentTicks = SDL_GetTicks();
+	_currentTicks = Locator::clock().now();
+	_sourceTicks = Locator::clock().source();
 	//This frame's length out of desired length
 	_speedFactor = (float)(_currentTicks-_frameDelay)/((float)_ticksPerSecond/_targetFps);
 	_fps = _targetFps/_speedFactor;
@@ -63,7 +68,7 @@ void Framerate::setSpeedFactor()
 	if (_currentTicks - fps_last > 1000)
 	{
 		//at least 1 second has elapsed
-		fps_last = SDL_GetTicks();
+		fps_last = _currentTicks;
 		fps_current = fps_count;
 		fps_count = 0;
 	}
@@ -73,9 +78,37 @@ void Framerate::setSpeedFactor()
 void Framerate::capFrames()
 {
 	//simple cap frame rate @ NNfps - ##TODO## - use TimeBasedAnimation see elsewhere
-	_ticks = SDL_GetTicks();
-	if (_ticks - _currentTicks < (Uint32)(1000/_targetFps))
-		SDL_Delay((Uint32)( (1000/_targetFps) - (_ticks - _currentTicks) ));	
+	//on the source clock, as game time doesn't move within a frame
+	if (_capFps == 0) return;
+	_ticks = Locator::clock().source();
+	if (_ticks - _sourceTicks < 1000/_capFps)
+		SDL_Delay((1000/_capFps) - (_ticks - _sourceTicks));
+}
+
+
+PhaseTimer::PhaseTimer(const std::string &name) :
+	_name(name), _freq(SDL_GetPerformanceFrequency())
+{
+	_start = _last = SDL_GetPerformanceCounter();
+}
+
+void PhaseTimer::mark(const std::string &phase)
+{
+	const Uint64 now = SDL_GetPerformanceCounter();
+	_phases.push_back(std::make_pair(phase, now - _last));
+	_last = now;
+}
+
+void PhaseTimer::report() const
+{
+	std::cout << _name << " timing:" << std::endl;
+	for (auto &p : _phases)
+		std::cout << "  " << std::left << std::setw(20) << p.first
+			<< std::right << std::fixed << std::setprecision(1) << std::setw(8)
+			<< (p.second * 1000.0 / _freq) << "ms" << std::endl;
+	std::cout << "  " << std::left << std::setw(20) << "total"
+		<< std::right << std::setw(8) << ((_last - _start) * 1000.0 / _freq) << "ms" << std::endl;
+	std::cout.unsetf(std::ios::floatfield | std::ios::adjustfield);
 }
 
 
@@ -4,7 +4,12 @@
 #define _FRAMERATE_H
 
 #include <SDL.h>
+#include <string>
+#include <utility>
+#include <vector>
 
+#define MAXIMUM_FRAME_RATE 60	//frame rate the speed factor is relative to, and the default cap
+
 class Framerate
 {
 public:
@@ -13,6 +18,7 @@ public:
 	void	init(float targetFps);
 	void	setSpeedFactor();
 	void	capFrames();
+	void	setCap(unsigned int fps) { _capFps = fps; }	//0 = no cap
 
 	//accessors
 	inline float speedFactor() const { return _speedFactor; }
@@ -21,9 +27,11 @@ public:
 
 private:
 	float		_targetFps;
+	unsigned int	_capFps;
 	float		_fps;
 	Uint32		_ticksPerSecond;
 	Uint32		_currentTicks;
+	Uint32		_sourceTicks;	//_currentTicks on the unscaled source, for capFrames
 	Uint32		_frameDelay;
 	float		_speedFactor;
 
@@ -35,5 +43,22 @@ private:
 
 };
 
+//named phase timings, eg. to see where startup time goes
+class PhaseTimer
+{
+public:
+	PhaseTimer(const std::string &name);
+
+	void	mark(const std::string &phase);	//end of the phase started at the previous mark
+	void	report() const;
+
+private:
+	std::string	_name;
+	Uint64		_freq;
+	Uint64		_start;
+	Uint64		_last;
+	std::vector<std::pair<std::string, Uint64> > _phases;
+};
+
 #endif //_FRAMERATE_H
 
@@ -52,6 +52,7 @@ Licence:		This program is free software; you can redistribute it and/or modify
 #include "platform.h"
 
 #include "audio.h"
+#include "clock.h"
 #include "framerate.h"
 #include "locator.h"
 
@@ -79,16 +80,197 @@ Licence:		This program is free software; you can redistribute it and/or modify
 
 #define MAX_FRAME_RATE 60
 
+//images precached by loadResources(), also decoded in the background at startup
+struct SImageRes
+{
+    const char *    file;
+    Uint32          tiles;
+    Image::eTileDir tileDir;
+};
+static const SImageRes _imageRes[] =
+{
+    { "roundel_letters.png", 26, Image::TILE_HORIZ },
+    { "roundel_kbd_letters.png", 26, Image::TILE_HORIZ },
+
+	//SINGLE FRAME BACKGROUNDS & IMAGES
+    { "menubg.png", 1, Image::TILE_HORIZ },		//solid background (no alpha)
+    { "menubg_plain.png", 1, Image::TILE_HORIZ },
+    { "menu_arcade.png", 1, Image::TILE_HORIZ },
+    { "menu_reword.png", 1, Image::TILE_HORIZ },
+    { "menu_speeder.png", 1, Image::TILE_HORIZ },
+    { "menu_timetrial.png", 1, Image::TILE_HORIZ },
+    { "scorebar.png", 1, Image::TILE_HORIZ },
+    { "game_arcade.png", 1, Image::TILE_HORIZ },
+    { "game_reword.png", 1, Image::TILE_HORIZ },
+    { "game_speeder.png", 1, Image::TILE_HORIZ },
+    { "game_timetrial.png", 1, Image::TILE_HORIZ },
+    { "popup_menu.png", 1, Image::TILE_HORIZ },
+
+	//IMAGE TILES (MULTIPLE TILE IMAGES)
+    { "cursors.png", 3, Image::TILE_HORIZ },
+    { "ping_small.png", 6, Image::TILE_HORIZ },
+    { "boxes.png", 24, Image::TILE_VERT },
+    { "scratch.png", 7, Image::TILE_HORIZ },
+
+    //BUTTONS
+    { "btn_round_scroll_up.png", 5, Image::TILE_HORIZ },
+    { "btn_round_scroll_down.png", 5, Image::TILE_HORIZ },
+    { "btn_round_scroll_left.png", 5, Image::TILE_HORIZ },
+    { "btn_round_scroll_right.png", 5, Image::TILE_HORIZ },
+    { "btn_round_scroll_up_small.png", 5, Image::TILE_HORIZ },
+    { "btn_round_scroll_down_small.png", 5, Image::TILE_HORIZ },
+
+    { "btn_round_word_shuffle.png", 5, Image::TILE_HORIZ },
+    { "btn_round_word_try.png", 5, Image::TILE_HORIZ },
+    { "btn_round_word_totop.png", 5, Image::TILE_HORIZ },
+    { "btn_round_word_last.png", 5, Image::TILE_HORIZ },
+
+    { "btn_square_menu.png", 5, Image::TILE_HORIZ },
+    { "btn_square_exit.png", 5, Image::TILE_HORIZ },
+    { "btn_square_next.png", 5, Image::TILE_HORIZ },
+    { "btn_square_back_small.png", 5, Image::TILE_HORIZ },
+    { "btn_square_exit_small.png", 5, Image::TILE_HORIZ },
+    { "btn_square_next_small.png", 5, Image::TILE_HORIZ },
+    { "btn_square_yes_no_small.png", 9, Image::TILE_HORIZ },
+    { "btn_square_diff.png", 13, Image::TILE_HORIZ },
+
+    { "btn_round_music.png", 9, Image::TILE_HORIZ },
+    { "btn_round_fx.png", 9, Image::TILE_HORIZ },
+
+    { "star.png", 7, Image::TILE_HORIZ },
+};
+
+//sound effects, in AUDIO_SFX_ order, and who wins a channel when they're all busy
+struct SSoundRes
+{
+    const char *    file;
+    unsigned int    id;
+    IAudio::eSfxPriority pri;
+};
+static const SSoundRes _soundRes[] =
+{
+    { "ping.wav", AUDIO_SFX_PING, IAudio::SFX_PRI_HIGH },
+    { "boing.wav", AUDIO_SFX_NOTINDICT, IAudio::SFX_PRI_NORMAL },
+    { "beepold.wav", AUDIO_SFX_ALREADYDONE, IAudio::SFX_PRI_NORMAL },
+    { "honk.wav", AUDIO_SFX_NOT6, IAudio::SFX_PRI_NORMAL },
+    { "binkbink.wav", AUDIO_SFX_FOUND6, IAudio::SFX_PRI_NORMAL },
+    { "blipper.wav", AUDIO_SFX_FOUNDNON6, IAudio::SFX_PRI_NORMAL },
+    { "fanfare.wav", AUDIO_SFX_ALLFOUND, IAudio::SFX_PRI_NORMAL },
+    { "woosh2.wav", AUDIO_SFX_JUMBLE, IAudio::SFX_PRI_LOW },
+    { "blipper.wav", AUDIO_SFX_ROUNDEL, IAudio::SFX_PRI_LOW },
+    { "blipper.wav", AUDIO_SFX_CONTROL, IAudio::SFX_PRI_LOW },
+};
+
+//images each screen uses, kept resident while it shows. Surfaces are
+//drawn onto (copied) to build a background rather than used as textures
+struct SScreenRes
+{
+    int             state;
+    const char *    file;
+    bool            bSurface;
+};
+static const SScreenRes _screenRes[] =
+{
+    { ST_MENU, "menubg.png", false },
+    { ST_MENU, "roundel_letters.png", false },
+    { ST_MENU, "roundel_kbd_letters.png", false },
+    { ST_MENU, "star.png", false },
+    { ST_MENU, "btn_round_music.png", false },
+
+    { ST_MODE, "menubg.png", false },
+    { ST_MODE, "roundel_letters.png", false },
+    { ST_MODE, "roundel_kbd_letters.png", false },
+    { ST_MODE, "star.png", false },
+    { ST_MODE, "btn_round_music.png", false },
+
+    { ST_DIFF, "menubg.png", false },
+    { ST_DIFF, "roundel_letters.png", false },
+    { ST_DIFF, "roundel_kbd_letters.png", false },
+    { ST_DIFF, "star.png", false },
+    { ST_DIFF, "btn_round_music.png", false },
+    { ST_DIFF, "btn_square_exit_small.png", false },
+
+    { ST_OPTN, "menubg.png", false },
+    { ST_OPTN, "roundel_letters.png", false },
+    { ST_OPTN, "roundel_kbd_letters.png", false },
+    { ST_OPTN, "star.png", false },
+    { ST_OPTN, "btn_round_music.png", false },
+    { ST_OPTN, "btn_square_yes_no_small.png", false },
+    { ST_OPTN, "btn_square_diff.png", false },
+    { ST_OPTN, "btn_square_exit_small.png", false },
+
+    { ST_INST, "menubg.png", false },
+    { ST_INST, "roundel_letters.png", false },
+    { ST_INST, "btn_round_scroll_up.png", false },
+    { ST_INST, "btn_round_scroll_down.png", false },
+    { ST_INST, "btn_round_music.png", false },
+    { ST_INST, "btn_square_exit_small.png", false },
+    { ST_INST, "btn_square_next_small.png", false },
+
+    { ST_GAME, "roundel_letters.png", false },
+    { ST_GAME, "cursors.png", false },
+    { ST_GAME, "scratch.png", false },
+    { ST_GAME, "boxes.png", false },
+    { ST_GAME, "ping_small.png", false },
+    { ST_GAME, "popup_menu.png", false },
+    { ST_GAME, "btn_round_music.png", false },
+    { ST_GAME, "btn_round_fx.png", false },
+    { ST_GAME, "btn_round_scroll_up_small.png", false },
+    { ST_GAME, "btn_round_scroll_down_small.png", false },
+    { ST_GAME, "btn_round_word_shuffle.png", false },
+    { ST_GAME, "btn_round_word_try.png", false },
+    { ST_GAME, "btn_round_word_totop.png", false },
+    { ST_GAME, "btn_round_word_last.png", false },
+    { ST_GAME, "btn_square_menu.png", false },
+    { ST_GAME, "btn_square_exit.png", false },
+    { ST_GAME, "btn_square_next.png", false },
+    { ST_GAME, "scorebar.png", false },
+    { ST_GAME, "game_arcade.png", false },
+    { ST_GAME, "game_reword.png", false },
+    { ST_GAME, "game_speeder.png", false },
+    { ST_GAME, "game_timetrial.png", false },
+
+    { ST_HIGH, "roundel_letters.png", false },
+    { ST_HIGH, "roundel_kbd_letters.png", false },
+    { ST_HIGH, "ping_small.png", false },
+    { ST_HIGH, "btn_round_scroll_up.png", false },
+    { ST_HIGH, "btn_round_scroll_down.png", false },
+    { ST_HIGH, "btn_round_scroll_left.png", false },
+    { ST_HIGH, "btn_round_scroll_right.png", false },
+    { ST_HIGH, "btn_round_music.png", false },
+    { ST_HIGH, "btn_square_exit_small.png", false },
+    { ST_HIGH, "btn_square_next_small.png", false },
+    { ST_HIGH, "menubg_plain.png", true },
+    { ST_HIGH, "menu_arcade.png", true },
+    { ST_HIGH, "menu_reword.png", true },
+    { ST_HIGH, "menu_speeder.png", true },
+    { ST_HIGH, "menu_timetrial.png", true },
+};
+
+//screens likely to follow each screen, preloaded in the background while it shows
+static const struct { int state, next; } _screenNext[] =
+{
+    { ST_MENU, ST_MODE }, { ST_MENU, ST_INST }, { ST_MENU, ST_HIGH }, { ST_MENU, ST_OPTN },
+    { ST_MODE, ST_DIFF }, { ST_MODE, ST_GAME },
+    { ST_DIFF, ST_GAME },
+    { ST_GAME, ST_HIGH }, { ST_GAME, ST_MENU },
+    { ST_HIGH, ST_MENU },
+    { ST_INST, ST_MENU },
+    { ST_OPTN, ST_MENU },
+};
+
 
 Game::Game() :
-	_init(false),
-	_screen(nullptr), _input(nullptr), _audio(nullptr), _gd(nullptr)
+	_init(false), _bHeadless(false),
+	_screen(nullptr), _input(nullptr), _script(nullptr), _optionsListener(0), _audio(nullptr), _gd(nullptr)
 {
 }
 
 Game::~Game()
 {
+	if (_gd) _gd->_options.unlisten(_optionsListener);
 	delete _gd;
+	Locator::registerEasing(nullptr);	//anything left releases into the null one
 
 	//now unload the SDL stuff
 	delete _screen;
@@ -120,6 +302,22 @@ void Game::splash()
 	}
 }
 
+//queue everything loadResources() will want on the loader threads, so the
+//png decodes and wav loads happen while the splash is up and the fonts and
+//words load. Anything already in the asset pack doesn't need decoding.
+void Game::preloadResources()
+{
+    for (auto &r : _imageRes)
+    {
+        const std::string fullName = RES_IMAGES + r.file;
+        if (!_pack.has(fullName))
+            _loader.queueImage(fullName);
+    }
+    if (_audio)
+        for (auto &r : _soundRes)
+            _loader.queueSound(RES_SOUNDS + r.file);   //duplicates only queued once
+}
+
 bool Game::loadResources()
 {
     bool bErr = false;
@@ -139,68 +337,17 @@ bool Game::loadResources()
     //};
 
 
-    bErr |= !Resource::image().add("roundel_letters.png", 26);
-    bErr |= !Resource::image().add("roundel_kbd_letters.png", 26);
-
-	//SINGLE FRAME BACKGROUNDS & IMAGES
-	bErr |= !Resource::image().add("menubg.png");		//solid background (no alpha)
-	bErr |= !Resource::image().add("menubg_plain.png");
-	bErr |= !Resource::image().add("menu_arcade.png");
-	bErr |= !Resource::image().add("menu_reword.png");
-	bErr |= !Resource::image().add("menu_speeder.png");
-	bErr |= !Resource::image().add("menu_timetrial.png");
-	bErr |= !Resource::image().add("scorebar.png");
-	bErr |= !Resource::image().add("game_arcade.png");
-	bErr |= !Resource::image().add("game_reword.png");
-	bErr |= !Resource::image().add("game_speeder.png");
-	bErr |= !Resource::image().add("game_timetrial.png");
-	bErr |= !Resource::image().add("popup_menu.png");
-
-	//IMAGE TILES (MULTIPLE TILE IMAGES)
-    bErr |= !Resource::image().add("cursors.png", 3);
-    bErr |= !Resource::image().add("ping_small.png", 6);
-
-	bErr |= !Resource::image().add("boxes.png", 24, ALPHA_COLOUR, 255, Image::TILE_VERT);
-	bErr |= !Resource::image().add("scratch.png", 7);
-
-    //BUTTONS
-	bErr |= !Resource::image().add("btn_round_scroll_up.png", 5);
-	bErr |= !Resource::image().add("btn_round_scroll_down.png", 5);
-	bErr |= !Resource::image().add("btn_round_scroll_left.png", 5);
-	bErr |= !Resource::image().add("btn_round_scroll_right.png", 5);
-	bErr |= !Resource::image().add("btn_round_scroll_up_small.png", 5);
-	bErr |= !Resource::image().add("btn_round_scroll_down_small.png", 5);
-
-	bErr |= !Resource::image().add("btn_round_word_shuffle.png", 5);
-	bErr |= !Resource::image().add("btn_round_word_try.png", 5);
-	bErr |= !Resource::image().add("btn_round_word_totop.png", 5);
-	bErr |= !Resource::image().add("btn_round_word_last.png", 5);
-
-    bErr |= !Resource::image().add("btn_square_menu.png", 5);
-    bErr |= !Resource::image().add("btn_square_exit.png", 5);
-    bErr |= !Resource::image().add("btn_square_next.png", 5);
-    bErr |= !Resource::image().add("btn_square_back_small.png", 5);
-    bErr |= !Resource::image().add("btn_square_exit_small.png", 5);
-    bErr |= !Resource::image().add("btn_square_next_small.png", 5);
-    bErr |= !Resource::image().add("btn_square_yes_no_small.png", 9);
-    bErr |= !Resource::image().add("btn_square_diff.png", 13);
-
-    bErr |= !Resource::image().add("btn_round_music.png", 9);
-    bErr |= !Resource::image().add("btn_round_fx.png", 9);
-
-	bErr |= !Resource::image().add("star.png", 7);
+    for (auto &r : _imageRes)
+        bErr |= !Resource::image().add(r.file, r.tiles, ALPHA_COLOUR, 255, r.tileDir);
 
     //sound resources
-    bErr |= Locator::audio().addSfx("ping.wav", AUDIO_SFX_PING) == -1;
-    bErr |= Locator::audio().addSfx("boing.wav", AUDIO_SFX_NOTINDICT) == -1;
-    bErr |= Locator::audio().addSfx("beepold.wav", AUDIO_SFX_ALREADYDONE) == -1;
-    bErr |= Locator::audio().addSfx("honk.wav", AUDIO_SFX_NOT6) == -1;
-    bErr |= Locator::audio().addSfx("binkbink.wav", AUDIO_SFX_FOUND6) == -1;
-    bErr |= Locator::audio().addSfx("blipper.wav", AUDIO_SFX_FOUNDNON6) == -1;
-    bErr |= Locator::audio().addSfx("fanfare.wav", AUDIO_SFX_ALLFOUND) == -1;
-    bErr |= Locator::audio().addSfx("woosh2.wav", AUDIO_SFX_JUMBLE) == -1;
-    bErr |= Locator::audio().addSfx("blipper.wav", AUDIO_SFX_ROUNDEL) == -1;
-    bErr |= Locator::audio().addSfx("blipper.wav", AUDIO_SFX_CONTROL) == -1;
+    for (auto &r : _soundRes)
+        bErr |= Locator::audio().addSfx(r.file, r.id, r.pri) == -1;
+
+    //per screen residency, anything else may be evicted once over budget
+    for (auto &r : _screenRes)
+        _images.addToSet(r.state, r.file, r.bSurface);
+    _images.setBudget((size_t)_gd->_options._imageBudgetMB * 1024 * 1024);
 
     return !bErr;   //true = success
 }
@@ -212,12 +359,21 @@ bool Game::init(GameOptions &options)
 	//sanity check
 	assert(false==_init);	//shouldn't be called once initialised successfully
 
+	Locator::registerClock(&_clock);	//stamped by play()
+
     Uint32 init_flags = SDL_INIT_EVERYTHING;
     if (!options._bSound)
     {
         std::cout << "Audio disabled" << std::endl;
         init_flags &= ~SDL_INIT_AUDIO;
     }
+    if (options._bHeadless)
+    {
+        std::cout << "Headless, on a virtual clock" << std::endl;
+        init_flags &= ~(SDL_INIT_AUDIO | SDL_INIT_VIDEO | SDL_INIT_JOYSTICK | SDL_INIT_GAMECONTROLLER | SDL_INIT_HAPTIC);
+        _clock.setVirtual(true);
+        _bHeadless = true;
+    }
 
 	//Init SDL but if anything borks, just exit
 	if ( SDL_Init(init_flags) < 0 )
@@ -227,6 +383,22 @@ bool Game::init(GameOptions &options)
 	}
 
 	atexit(SDL_Quit);	//auto cleanup, just in case
+	PhaseTimer timer("Startup");
+	timer.mark("SDL init");
+
+	//before anything asks for a random seed
+	if (!options._replayFile.empty() || !options._recordFile.empty())
+	{
+		if (!options._replayFile.empty() ? !_trace.replay(options._replayFile) : !_trace.record(options._recordFile))
+		{
+			setLastError("Unable to open trace");
+			return false;
+		}
+		Locator::registerTrace(&_trace);
+	}
+	Locator::registerTimers(&_timers);	//ticked by play()
+	Locator::registerEasing(&_easing);	//ticked by play()
+	Locator::registerRandom(&_random);	//seeded by GameData::init()
 
     //Set texture filtering to linear
     if( !SDL_SetHint( SDL_HINT_RENDER_SCALE_QUALITY, "1" ) )
@@ -239,15 +411,31 @@ bool Game::init(GameOptions &options)
     else
         Locator::registerAudio(_audio = new Audio());
     IAudio &audio = Locator::audio();
+    audio.setBufferSize(options._audioBuffer);
     audio.setup(options._bDefaultSfxOn, options._bDefaultMusicOn, options._defaultMusicDir, options._bMute);
+    timer.mark("audio");
 
-	_screen  = new Screen(SCREEN_WIDTH, SCREEN_HEIGHT, "REWORD");
+	_screen  = new Screen(SCREEN_WIDTH, SCREEN_HEIGHT, "REWORD", options._bHeadless, options._bVsync);
 	if (!_screen->initDone())
 	{
 		setLastError(_screen->lastError());
 		return false;
 	}
 	Locator::registerScreen(_screen);
+
+    //pre-decoded images and font metrics, or capture them all if baking a new pack
+    Resource::registerPack(&_pack);
+    if (options._bBake)
+    {
+        SDL_RendererInfo info;
+        Uint32 format = SDL_PIXELFORMAT_ARGB8888;
+        if (SDL_GetRendererInfo(_screen->renderer(), &info) == 0 && info.num_texture_formats > 0)
+            format = info.texture_formats[0];   //renderers preferred format
+        _pack.setRecording(true, format);
+    }
+    else
+        _pack.open(RES_ASSETPACK);
+    timer.mark("screen + pack");
 
     //Initialize PNG loading
     int imgFlags = IMG_INIT_PNG;
@@ -259,6 +447,13 @@ bool Game::init(GameOptions &options)
         return false;
     }
 
+    //start decoding the images and sounds in the background. The words are
+    //parsed there too, from GameData::init()
+    Resource::registerLoader(&_loader);
+    _loader.start(options._workerThreads);
+    preloadResources();
+    timer.mark("queue preload");
+
 #if (defined(GP2X) || defined(PANDORA))
     uint8_t hiddenCursorData = 0;
     hiddenCursor = SDL_CreateCursor(&hiddenCursorData, &hiddenCursorData, 8, 1, 0, 0);
@@ -277,6 +472,7 @@ bool Game::init(GameOptions &options)
     //SDL_ShowCursor (0);	//hide - place here after video init else stays on screen on GP2X
 #endif
 	splash();				//show splash png not text
+	timer.mark("splash");
 
 	//Initialize SDL_ttf
 	if( TTF_Init() == -1 )
@@ -285,9 +481,20 @@ bool Game::init(GameOptions &options)
 		return false;
 	}
 
-	_input = new Input();
+	if (options._bHeadless && !_trace.isReplaying())
+	{
+		_input = _script = options._bBot ? new BotInput(options._botSkill, options._botThinkMs) : new ScriptInput();
+		if (!options._bBot && !_script->load(options._simScript))
+		{
+			setLastError("Unable to load headless script");
+			return false;
+		}
+	}
+	else
+		_input = new Input();
 	Locator::registerInput(_input);
 	_input->init();
+	timer.mark("ttf + input");
 
 #if ((defined(GP2X) || defined(PANDORA)))
 	//SDL_Init(SDL_INIT_JOYSTICK | SDL_INIT_VIDEO);
@@ -295,12 +502,14 @@ bool Game::init(GameOptions &options)
 #endif
 
 	//load all game data (images, fonts, etc, etc)
-	_gd = new GameData();
-	_gd->setOptions(options);
+	_gd = new GameData(options);
 	_gd->_current_w = _screen->width();
 	_gd->_current_h = _screen->height();
 	_gd->init(); //load main resources
     Locator::registerData(_gd);
+    _framerate.setCap(options._frameCap);
+    _optionsListener = options.listen([this](eOption opt) { optionChanged(opt); });
+    timer.mark("game data");
 
 #if defined(_USE_OGG)
 	//load mp3/ogg menu music
@@ -324,6 +533,15 @@ bool Game::init(GameOptions &options)
 		setLastError("Unable to load resources");
 		return false;
 	}
+    timer.mark("resources");
+
+    if (options._bBake && !_pack.save(RES_ASSETPACK))
+    {
+        setLastError("Unable to save asset pack");
+        return false;
+    }
+    _pack.close();  //anything loaded later comes from the files
+    timer.report(); //loader stays running to preload each next screen
 
 
     if (Locator::data()._fntTiny.description() != "Sans tiny")
@@ -346,6 +564,16 @@ bool Game::run(void)
 	bool b = true;
 	while (b &&_gd->_state != ST_EXIT)
 	{
+		if (_bHeadless) _stats.screenStart();
+
+		//load this screens images (the last screen has released its own by
+		//now) and start decoding the ones the next screen is likely to need
+		const int set = (_gd->_state == ST_RESUME) ? ST_GAME : (_gd->_state == ST_HIGHEDIT) ? ST_HIGH : _gd->_state;
+		Resource::image().enterSet(set);
+		for (auto &n : _screenNext)
+			if (n.state == set)
+				Resource::image().preloadSet(n.next);
+
 		switch (_gd->_state)
 		{
 		case ST_MENU:		p = new PlayMainMenu(*_gd);break;
@@ -371,13 +599,37 @@ bool Game::run(void)
 		delete p;
 	}
 
+	if (_bHeadless) _stats.report(_script ? _script->tried() : 0);
+
+	//anything changed in the last moments hasn't been written by the timer yet
+	_gd->_options.save();
+	//finish the background writes (a Save & Exit quick save, the personal
+	//words) here, rather than trusting them to destructors on the way out
+	_gd->flush();
+	_loader.stop();
 	std::cout << "Exiting Reword - all ok" << std::endl;
 
 	return b;
 }
 
 
-#define MAXIMUM_FRAME_RATE 60
+//options changed while running (from the options screen), so the services
+//pick them up without checking each frame. Words reload in GameData
+void Game::optionChanged(eOption opt)
+{
+	const GameOptions &options = _gd->_options;
+	switch (opt)
+	{
+	case OPT_DEFAULTSFX:		Locator::audio().setSfxEnabled(options._bDefaultSfxOn); break;
+	case OPT_DEFAULTMUSIC:		Locator::audio().setMusicEnabled(options._bDefaultMusicOn); break;
+	case OPT_DEFAULTMUSICDIR:	Locator::audio().setBaseTrackDir(options._defaultMusicDir); break;
+	case OPT_FRAMECAP:			_framerate.setCap(options._frameCap); break;
+	case OPT_IMAGEMB:			_images.setBudget((size_t)options._imageBudgetMB * 1024 * 1024); break;
+	default:					break;	//only read at startup, or as needed
+	}
+}
+
+
 //#define MINIMUM_FRAME_RATE 15
 //#define UPDATE_INTERVAL (1.0 / MAXIMUM_FRAME_RATE)	//0.0166666
 //#define MAX_CYCLES_PER_FRAME (MAXIMUM_FRAME_RATE / MINIMUM_FRAME_RATE)	//4
@@ -387,7 +639,7 @@ bool Game::play(IPlay *p)
 {
     if (nullptr == p) return false;    //invalid IPlay object
 
-	bool bCap = true;
+	bool bCap = !_bHeadless;	//headless runs flat out
 #ifdef GP2X
 	int touchX(0), touchY(0);
 #endif
@@ -406,16 +658,32 @@ bool Game::play(IPlay *p)
 //  //void *buffer =
 //      mmap(0, SCREEN_WIDTH*SCREEN_HEIGHT*2, PROT_WRITE, MAP_SHARED, fbdev, 0);
 #endif
-	// Initialise play/level specific stuff
+	// Initialise play/level specific stuff, at a game time moved on past the
+	// loading. Traced as a frame of its own, so a replay moves the clock on the
+	// same before init() starts any timers (the countdown)
+	if (_trace.isReplaying())
+	{
+		_clock.advance(_trace.nextFrame());
+		_trace.feed();	//never has any events, just steps on to the next frame
+	}
+	const Uint32 initAt = _clock.stamp();		//loading may have taken a while
+	if (_trace.isRecording()) _trace.frame(initAt);
 	p->init(_input, _screen);
+	if (_bHeadless) _stats.screenReady(_gd->_words.getWordTarget());
 
-	Framerate fr;
-	fr.init(MAXIMUM_FRAME_RATE);
+	_framerate.init(MAXIMUM_FRAME_RATE);
 
     // Main loop
     while(p->running())
     {
-		fr.setSpeedFactor();
+		if (_trace.isReplaying())
+			_clock.advance(_trace.nextFrame());	//as long as this frame took when recorded
+		const Uint32 now = _clock.stamp();		//the one game time for the whole frame
+		if (_script)
+			_script->feed(now);
+		if (_bHeadless) _stats.startFrame();
+		if (_trace.isRecording()) _trace.frame(now);
+		_framerate.setSpeedFactor();
 
 /*
 		//tinkering...
@@ -429,15 +697,26 @@ bool Game::play(IPlay *p)
 			updateIterations -= UPDATE_INTERVAL;
 			// Update game state a variable number of times
 */
+			//every eased sprite to this frames position, before they're worked
+			_easing.tick(now);
+
 			// Do work/think stuff
 			//_gd->_fact = fr.speedFactor();
-			p->work(_input, fr.speedFactor());
+			p->work(_input, _framerate.speedFactor());
 
 			_gd->_effects.work();
 
+			//countdown etc. Any events they push are handled below, this frame
+			_timers.tick(now);
+
+			//recorded input for this frame
+			if (_trace.isReplaying()) _trace.feed();
+
 			// Handle SDL events
 			while (SDL_PollEvent(&event))
 			{
+				if (_trace.isRecording()) _trace.event(event);
+
 				switch (event.type)
 				{
 					// Handle keys
@@ -549,6 +828,15 @@ bool Game::play(IPlay *p)
 					case SDL_QUIT:
 						return true;	//valid exit
 
+					case SDL_WINDOWEVENT:
+						//game time, so the countdown too, stands still while minimised
+						if (SDL_WINDOWEVENT_MINIMIZED == event.window.event)
+							_clock.pause(true);
+						else if (SDL_WINDOWEVENT_RESTORED == event.window.event)
+							_clock.pause(false);
+						p->handleEvent(event);
+						break;
+
 					default:
 						//ok, here we handle all *our* events, user defined or pass on
 						//any others in case it's handled elsewhere (ie, in game level)
@@ -583,6 +871,7 @@ bool Game::play(IPlay *p)
 //				p->touch(Point(touchX, touchY));
 //			}
 //#endif
+		if (_bHeadless) _stats.endWork();
 
 /*
 		//tinkering...
@@ -599,7 +888,7 @@ bool Game::play(IPlay *p)
         _gd->_effects.draw(_screen);
 
 #ifdef _DEBUG	//overlay the framerate and any other debug info required
-		_gd->_fntSmall.put_number(_screen,0,60,fr.fps(),"%d", BLACK_COLOUR);
+		_gd->_fntSmall.put_number(_screen,0,60,_framerate.fps(),"%d", BLACK_COLOUR);
 #endif
 
 
@@ -618,7 +907,21 @@ bool Game::play(IPlay *p)
 		_screen->unlock();
 		_screen->update();
 
-		if (bCap) fr.capFrames();
+		if (_bHeadless)
+		{
+			_stats.endFrame(_gd->_words.getWordTarget());
+			if (!_trace.isReplaying())
+				_clock.advance(1000 / MAXIMUM_FRAME_RATE);	//every frame is exactly one frame long
+
+			if (_trace.isReplaying() ? _trace.finished() :
+				(_stats.levels() > _gd->_options._simLevels || _script->finished()))
+			{
+				_gd->_state = ST_EXIT;
+				return true;	//end of the trace, or wanted number of levels played (and the next one started)
+			}
+		}
+
+		if (bCap) _framerate.capFrames();
 
 //#ifdef _USE_MIKMOD
 //		Locator::audio().modUpdate();
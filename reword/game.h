@@ -11,6 +11,13 @@
 #include "i_play.h"	    //IPlay interface decl
 #include "gamedata.h"
 #include "resource.h"
+#include "headless.h"
+#include "bot.h"
+#include "clock.h"
+#include "trace.h"
+#include "timerwheel.h"
+#include "random.h"
+#include "framerate.h"
 
 class Game : public Error
 {
@@ -23,17 +30,31 @@ public:
 
 protected:
 	void		splash();
+    void        preloadResources();
     bool        loadResources();
 	bool		play(IPlay *p);
+	void		optionChanged(eOption opt);
 
 private:
 	bool		_init;
+	bool		_bHeadless;	//no display, virtual clock (scripted or replaying a trace)
 
 	Screen		*_screen;
 	Input		*_input;
+	ScriptInput	*_script;	//set if headless, same object as _input
+	SimStats	_stats;
+	Clock		_clock;		//game time, stamped each frame
+	Trace		_trace;		//input record or replay, if asked for
+	TimerWheel	_timers;	//main loop timers (game countdown)
+	Easing		_easing;	//every sprites eased move, ticked by play()
+	RandomStreams	_random;	//random numbers, reseeded with the word list
+	Framerate	_framerate;	//speed factor and frame cap for play()
+	unsigned int	_optionsListener;
 	IAudio		*_audio;
 	GameData	*_gd;
     ResourceImg	_images;
+    AssetPack   _pack;
+    AsyncLoader _loader;
 
     SDL_Cursor *hiddenCursor;
 };
@@ -41,15 +41,41 @@ Licence:		This program is free software; you can redistribute it and/or modify
 #include "platform.h"
 #include "score.h"
 #include "helpers.h"
+#include "resource.h"
+#include "locator.h"
+#include "framerate.h"
 
+#include <ctime>
+#include <cstdlib>
+#include <fstream>
+#include <future>
 #include <iostream>
+#include <sstream>
 
-GameData::GameData() : _bTouch(false),  _init(false)
+//options for a GameData that's never init()'d, eg. the Locator's null one
+static GameOptions &nullOptions()
+{
+	static GameOptions options;
+	return options;
+}
+
+GameData::GameData() : _options(nullOptions()), _bTouch(false),  _init(false), _optionsListener(0)
 {
 }
 
 GameData::GameData(GameOptions &opt) : _options(opt), _bTouch(false),  _init(false)
 {
+	_optionsListener = _options.listen([this](eOption opt) { optionChanged(opt); });
+}
+
+//written back next to the scores (see QuickState), and read by rewordlist as a .include
+static std::string personalWordsFile()
+{
+#ifdef PANDORA
+	return "./personal.include";
+#else
+	return RES_BASE + "personal.include";
+#endif
 }
 
 void GameData::init()
@@ -60,30 +86,37 @@ void GameData::init()
 	//SCORES ETC - load scores for this wordfile
     Uint32 hash = _score.loadUsingWordfileName(_options._defaultWordFile);
 
-	//LOAD WORDS - 	pass score hash + ticks as random seed
-	bErr |= !_words.load(RES_WORDS + _options._defaultWordFile, hash + SDL_GetTicks());
+	//LOAD WORDS - 	pass score hash + ticks as random seed (or the recorded one if replaying).
+	//Parsed on a loader thread while the fonts load, collected at the end
+	const std::string wordFile = RES_WORDS + _options._defaultWordFile;
+	const Uint32 seed = Locator::trace().seed(hash + Locator::clock().source());
+	Locator::random().setSeed(seed);	//so a replay jumbles the letters the same way too
+	//with the player's own words, except for headless or replayed runs which
+	//need the same dictionary every time
+	const bool bPersonal = !_options._bHeadless && !Locator::trace().isReplaying();
+	std::future<bool> wordsLoaded = Resource::loader().queueJob([this, wordFile, seed, bPersonal]()
+        {
+            if (bPersonal && _personal.open(personalWordsFile()))
+                _words.setPersonal(_personal.accepted());
+            return _words.load(wordFile, seed);
+        });
 
-	//FONTS
+    //SOUNDS - sound effects are owned by Audio (see Game::loadResources())
+
+	//FONTS - textures, so has to be on this thread
+	const Uint32 fontTicks = SDL_GetTicks();
 	bErr |= !_fntTiny.loadBMP(RES_FONTS + "arial_14.fnt", "Tiny");					//14 for under found words
 	bErr |= !_fntSmall.loadBMP(RES_FONTS + "arial_16.fnt", "small");				//18 for under menu etc
 	bErr |= !_fntMed.loadBMP(RES_FONTS + "BD_Cartoon_Shout_26.fnt", "medium font");	//used for main menu text etc
 	bErr |= !_fntBig.loadBMP(RES_FONTS + "BD_Cartoon_Shout_34.fnt", "Cartoon big");	// main menu 
 	bErr |= !_fntClean.loadBMP(RES_FONTS + "arial_22.fnt", "small clean");
+	std::cout << "Fonts loaded in " << SDL_GetTicks() - fontTicks << "ms"
+        << (Resource::pack().isOpen() ? " (asset pack)" : "") << std::endl;
 
-    if (!bErr)
-    {
-        //SOUNDS - no wrapper class so need to free on exit
-        _fxCountdown = Mix_LoadWAV(std::string(RES_SOUNDS + "ping.wav").c_str());	//<10 seconds remaining
-        _fxBadword = Mix_LoadWAV(std::string(RES_SOUNDS + "boing.wav").c_str());	//word not in dict
-        _fxOldword = Mix_LoadWAV(std::string(RES_SOUNDS + "beepold.wav").c_str());	//word already picked
-        _fx6notfound = Mix_LoadWAV(std::string(RES_SOUNDS + "honk.wav").c_str());	//not found a 6 letter word
-        _fx6found = Mix_LoadWAV(std::string(RES_SOUNDS + "binkbink.wav").c_str());	//found a/the 6 letter word
-        _fxFound = Mix_LoadWAV(std::string(RES_SOUNDS + "blipper.wav").c_str());	//found a non 6 letter word
-        _fxBonus = Mix_LoadWAV(std::string(RES_SOUNDS + "fanfare.wav").c_str());	//all words done before countdown
-        _fxWoosh = Mix_LoadWAV(std::string(RES_SOUNDS + "woosh2.wav").c_str());		//jumble letters sound
-        _fxRoundel = Mix_LoadWAV(std::string(RES_SOUNDS + "blipper.wav").c_str());	//roundel press
-        _fxControl = Mix_LoadWAV(std::string(RES_SOUNDS + "blipper.wav").c_str());	//control press
+    bErr |= !wordsLoaded.get();
 
+    if (!bErr)
+    {
         //#ifdef _USE_MIKMOD
         _musicMenu = Mix_LoadMUS(std::string(RES_SOUNDS + "cascade.mod").c_str());	//in sounds, not music dir
         std::cerr << "Mix_LoadMUS cascade.mod result : " << Mix_GetError() << std::endl;
@@ -100,6 +133,7 @@ void GameData::init()
 	setDiffLevel(_options._defaultDifficulty);
 	//default to "classic" game mode
 	_mode = GM_ARCADE;
+	_challenge = 0;
 
 	//finally, are we done? If bErr was set true anywhere above then don't set _init true
 	_init = !bErr;
@@ -110,19 +144,20 @@ GameData::~GameData()
 	//other specific resources to clear up
     if (_init)
     {
-        Mix_FreeChunk(_fxBadword);
-        Mix_FreeChunk(_fxOldword);
-        Mix_FreeChunk(_fxCountdown);
-        Mix_FreeChunk(_fx6notfound);
-        Mix_FreeChunk(_fx6found);
-        Mix_FreeChunk(_fxFound);
-        Mix_FreeChunk(_fxBonus);
-        Mix_FreeChunk(_fxWoosh);
-        Mix_FreeChunk(_fxRoundel);
-        Mix_FreeChunk(_fxControl);
-
         Mix_FreeMusic(_musicMenu);
     }
+    if (_qsWrite.valid()) _qsWrite.wait();	//don't lose a save made on the way out
+    _options.unlisten(_optionsListener);
+}
+
+void GameData::optionChanged(eOption opt)
+{
+	if (opt == OPT_DEFAULTWORDFILE && _init)
+	{
+		//load newly selected word file, and the scores for it
+		_words.load(RES_WORDS + _options._defaultWordFile, Locator::trace().seed(Locator::clock().source()));
+		_score.loadUsingWordfileName(_options._defaultWordFile);
+	}
 }
 
 //set the relevant vars (value, name, colour) for the difficulty level
@@ -133,26 +168,67 @@ void GameData::setDiffLevel(eGameDiff newDiff)
 	_diffColour = (_diffLevel==DIF_EASY)?GREEN_COLOUR:(_diffLevel==DIF_MED)?ORANGE_COLOUR:RED_COLOUR;
 }
 
-//write/overwrite quickstate save file
-void GameData::saveQuickState()
+//write/overwrite quickstate save file, on a loader thread so a pause doesn't
+//stall a frame. Writes are done in order, as each waits for the last
+void GameData::saveQuickState(const tQuickStateSave &level)
 {
-	tQuickStateSave	qss;
+	tQuickStateSave	qss = level;
 	qss._wordfile = _options._defaultWordFile;
 	qss._words = _score.currWords();
 	qss._score =  _score.currScore();
 	qss._diff = (int)_diffLevel;
 	qss._mode = (int)_mode;
 	qss._seed = _score.seed();
+	qss._challenge = _challenge;
+
+	if (_qsWrite.valid()) _qsWrite.wait();
+	_qsWrite = Resource::loader().queueJob([qss]()
+	{
+		QuickState qs;
+		qs.setQuickState(qss);
+		return qs.quickStateSave();
+	});
+}
+
+void GameData::flush()
+{
+	if (_qsWrite.valid()) _qsWrite.wait();
+	_personal.flush();
+}
+
+void GameData::deleteQuickState()
+{
+	if (_qsWrite.valid()) _qsWrite.wait();
 	QuickState qs;
-	qs.setQuickState(qss);
-	qs.quickStateSave();
+	qs.quickStateDelete();
+}
+
+//the local date as YYYYMMDD, so everyone playing today gets the same targets.
+//Logged like a seed, so a replay gets the recorded day's
+Uint32 GameData::dailyChallengeKey()
+{
+	const std::time_t now = std::time(nullptr);
+	const std::tm *t = std::localtime(&now);
+	const Uint32 date = t ? (t->tm_year + 1900) * 10000 + (t->tm_mon + 1) * 100 + t->tm_mday : 1;
+	return Locator::trace().seed(date);
+}
+
+//log the words tried this level that aren't in the dictionary
+void GameData::savePersonalWords()
+{
+	tWordSet words;
+	for (auto &w : _unmatchedWords)
+		if (!_words.isWord(w)) words.insert(w);	//too short for this level, but real words
+	_personal.capture(words);
+	_unmatchedWords.clear();
 }
 
 //restore the last quick save state and allow resume playing at the next word
 //in the word list (using the same random gen seed, so the list will be the
-//same 'random' order).
+//same 'random' order), or part way through the level it was saved in.
 bool GameData::loadQuickState()
 {
+	if (_qsWrite.valid()) _qsWrite.wait();
 	QuickState qs;
 	if (qs.quickStateLoad())
 	{
@@ -165,11 +241,17 @@ bool GameData::loadQuickState()
 		_mode = (eGameMode)qss._mode;
 		_score.setSeed(qss._seed);
 
-		//load same word file as last load, same seed, next word on
-		if (!_words.load(RES_WORDS + qss._wordfile, qss._seed, qss._words+1))
+		//a snapshot holds the list position, older saves the words played so far
+		const unsigned int startAtWord = qss._bLevel ? qss._position : qss._words+1;
+		bool bLoaded = false;
+		if (_words.wordFile() == RES_WORDS + qss._wordfile)
+			bLoaded = _words.restart(qss._seed, startAtWord);	//already parsed, just reorder
+		if (!bLoaded && !_words.load(RES_WORDS + qss._wordfile, qss._seed, startAtWord))
         {
+            qss._bLevel = false;
+            qss._challenge = 0;		//not the same challenge with another word file
             std::cerr << "Fall back to default word file" << std::endl;
-            if (!_words.load(RES_WORDS + _options._defaultWordFile, SDL_GetTicks()))
+            if (!_words.load(RES_WORDS + _options._defaultWordFile, Locator::trace().seed(Locator::clock().source())))
             {
                 //user won't see much without a word file - don't know how this'll end...
                 std::cerr << "Cannot load default word file" << std::endl;
@@ -177,6 +259,17 @@ bool GameData::loadQuickState()
             }
         }
 
+		_challenge = qss._challenge;
+		_words.setChallenge(_challenge, _diffLevel, startAtWord);
+
+		//back into the level, as PlayGame::newLevel() would have left it
+		if (qss._bLevel && !(_words.setWord(qss._target, _mode) && _words.setFound(qss._found)))
+		{
+			std::cerr << "Cannot resume level " << qss._target << ", starting the next" << std::endl;
+			qss._bLevel = false;
+		}
+		_resume = qss;
+
 		qs.quickStateDelete();	//remove last quick save file
 		return true;
 	}
@@ -184,11 +277,89 @@ bool GameData::loadQuickState()
 }
 
 
+#define OPTIONS_SAVE_MS	2000	//options file written once they've been left alone this long
+
+//the registry - every option set() knows, by eOption
+struct SOptionDef
+{
+	const char *	key;		//in the options file, and --key=value on the command line
+	char			type;		//b(ool), u(nsigned int), s(tring) or d(ifficulty)
+	unsigned int	min, max;	//valid values for u and d
+	bool			bSaved;		//in the options file, else command line only
+	const char *	help;
+};
+
+static const SOptionDef s_options[OPT_MAX] = {
+	{ "singletap",			'b', 0, 1,			true,	"menus select on a single tap" },
+	{ "defaultsfx",			'b', 0, 1,			true,	"sound effects on" },
+	{ "defaultmusic",		'b', 0, 1,			true,	"music on" },
+	{ "defaultdiff",		'd', DIF_EASY, DIF_HARD, true, "difficulty, 1 easy to 3 hard" },
+	{ "defaultmusicdir",	's', 0, 0,			true,	"music directory" },
+	{ "defaultwordfile",	's', 0, 0,			true,	"word file, in the words directory" },
+	{ "framecap",			'u', 0, 1000,		true,	"frames a second, 0 for no cap" },
+	{ "vsync",				'b', 0, 1,			true,	"wait for the display to refresh (at startup)" },
+	{ "workers",			'u', 0, 64,			true,	"loader threads, 0 for one per core up to 4 (at startup)" },
+	{ "imagemb",			'u', 0, 4096,		true,	"cached images in MB, 0 for no limit" },
+	{ "audiobuf",			'u', 0, 65536,		true,	"sound mixed in buffers of this many samples, 0 for the platform's (at startup)" },
+	{ "levels",				'u', 1, 1000000,	false,	"headless runs stop after this many levels" },
+	{ "skill",				'u', 0, 100,		false,	"bot finds this % of the words" },
+	{ "think",				'u', 0, 60000,		false,	"bot takes about this many ms to find each word" },
+};
+
+//the member holding each option, of its type (nullptr if it's another type)
+template<typename O> static auto boolOption(O &o, eOption opt) -> decltype(&o._bVsync)
+{
+	switch (opt)
+	{
+	case OPT_SINGLETAP:		return &o._bSingleTapMenus;
+	case OPT_DEFAULTSFX:	return &o._bDefaultSfxOn;
+	case OPT_DEFAULTMUSIC:	return &o._bDefaultMusicOn;
+	case OPT_VSYNC:			return &o._bVsync;
+	default:				return nullptr;
+	}
+}
+
+template<typename O> static auto uintOption(O &o, eOption opt) -> decltype(&o._frameCap)
+{
+	switch (opt)
+	{
+	case OPT_FRAMECAP:		return &o._frameCap;
+	case OPT_WORKERS:		return &o._workerThreads;
+	case OPT_IMAGEMB:		return &o._imageBudgetMB;
+	case OPT_AUDIOBUF:		return &o._audioBuffer;
+	case OPT_LEVELS:		return &o._simLevels;
+	case OPT_SKILL:			return &o._botSkill;
+	case OPT_THINK:			return &o._botThinkMs;
+	default:				return nullptr;
+	}
+}
+
+template<typename O> static auto stringOption(O &o, eOption opt) -> decltype(&o._defaultWordFile)
+{
+	switch (opt)
+	{
+	case OPT_DEFAULTMUSICDIR:	return &o._defaultMusicDir;
+	case OPT_DEFAULTWORDFILE:	return &o._defaultWordFile;
+	default:				return nullptr;
+	}
+}
+
+static bool writeOptions(const std::string &fileName, const std::string &text)
+{
+	std::string error;
+	if (ppfile::writeFileAtomic(fileName, text.data(), text.size(), error))
+		return true;
+	std::cerr << "Cannot save options file: " << error << std::endl;
+	return false;
+}
+
 GameOptions::GameOptions() :
-    _bSound(true), _bMute(false),
+    _bSound(true), _bMute(false), _bBake(false), _imageBudgetMB(IMAGE_BUDGET_MB), _audioBuffer(0),
+    _bHeadless(false), _simLevels(20), _bBot(false), _botSkill(80), _botThinkMs(800),
+    _frameCap(MAXIMUM_FRAME_RATE), _bVsync(false), _workerThreads(0),
     _bSingleTapMenus(true), _bDefaultSfxOn(true), _bDefaultMusicOn(true),
     _defaultDifficulty(DIF_MED),   //medium diff
-    _bDirty(false)
+    _bDirty(false), _nextListener(1), _bSaveQueued(false), _changedAt(0)
 {
     _defaultWordFile = "eng_british_oxford.txt"; //"words/" gets prepended
     _defaultMusicDir = "music/";
@@ -199,6 +370,8 @@ GameOptions::GameOptions() :
 #else
 	_optionsFile = RES_BASE + "options.dat";
 #endif
+    for (int opt = 0; opt < OPT_MAX; ++opt)
+        _saved[opt] = get((eOption)opt);
 }
 
 GameOptions::~GameOptions()
@@ -215,22 +388,11 @@ bool GameOptions::load()
 		while (std::getline(infile, line, '\n'))
 		{
 			pptxt::splitKeyValuePair(line, key, value);
-			if (key == "singletap")
-				_bSingleTapMenus = atoi(value.c_str()) != 0;
-			else if (key == "defaultsfx")
-				_bDefaultSfxOn = atoi(value.c_str()) != 0;
-			else if (key == "defaultmusic")
-				_bDefaultMusicOn = atoi(value.c_str()) != 0;
-			else if (key == "defaultdiff")
+			for (int opt = 0; opt < OPT_MAX; ++opt)
 			{
-			    int diff = atoi(value.c_str());
-			    if (diff > (int)DIF_UNDEFINED && diff < (int)DIF_MAX)
-                    _defaultDifficulty = (eGameDiff)diff;
+				if (s_options[opt].bSaved && key == s_options[opt].key && set((eOption)opt, value, false))
+					_saved[opt] = get((eOption)opt);
 			}
-			else if (key == "defaultmusicdir")
-				_defaultMusicDir = value.c_str();
-			else if (key == "defaultwordfile")
-				_defaultWordFile = value.c_str();
 		}
 		_bDirty = false;
 		return true;
@@ -239,59 +401,163 @@ bool GameOptions::load()
 	return false;
 }
 
+//write the options now, after any being written in the background
 bool GameOptions::save()
 {
+    if (_write.valid()) _write.wait();
     if (!_bDirty) return false;
-	//save options as simple text pairs
- 	std::ofstream outfile(_optionsFile.c_str(), std::ios::out|std::ifstream::trunc);
-	if (outfile.is_open())
-	{
-		outfile << "Reword=" << VERSION_STRING << std::endl;
-		outfile << "singletap=" << _bSingleTapMenus << std::endl;
-		outfile << "defaultsfx=" << _bDefaultSfxOn << std::endl;
-		outfile << "defaultmusic=" << _bDefaultMusicOn << std::endl;
-		outfile << "defaultdiff=" << _defaultDifficulty << std::endl;
-		outfile << "defaultmusicdir=" << _defaultMusicDir << std::endl;
-		outfile << "defaultwordfile=" << _defaultWordFile << std::endl;
-	}
-	_bDirty = false;
-    return true;
+    _bDirty = false;
+    return writeOptions(_optionsFile, text());
 }
 
-bool GameOptions::setDefaultWordFile(const std::string &wordFile)
+//save options as simple text pairs
+std::string GameOptions::text() const
+{
+    std::ostringstream out;
+    out << "Reword=" << VERSION_STRING << std::endl;
+    for (int opt = 0; opt < OPT_MAX; ++opt)
+        if (s_options[opt].bSaved) out << s_options[opt].key << "=" << _saved[opt] << std::endl;
+    return out.str();
+}
+
+//called by the timer wheel. Written on a loader thread, so the options screen
+//doesn't stall on the file, but only once nothing has changed for a while
+Uint32 GameOptions::saveTick()
+{
+    const Uint32 idle = Locator::clock().now() - _changedAt;
+    if (idle < OPTIONS_SAVE_MS) return OPTIONS_SAVE_MS - idle;    //changed again, wait for it to settle
+    _bSaveQueued = false;
+    if (_bDirty)
+    {
+        if (_write.valid()) _write.wait();
+        const std::string fileName = _optionsFile, options = text();
+        _write = Resource::loader().queueJob([fileName, options]() { return writeOptions(fileName, options); });
+        _bDirty = false;
+    }
+    return 0;
+}
+
+//change an option from its text. Saved once changes settle unless !bSave,
+//as for the command line, which only changes it for this run
+bool GameOptions::set(eOption opt, const std::string &value, bool bSave /*= true*/)
 {
-    if (_defaultWordFile!= wordFile)
+    if (opt < 0 || opt >= OPT_MAX) return false;
+    const SOptionDef &def = s_options[opt];
+    const std::string old = get(opt);
+    if (def.type == 's')
+        *stringOption(*this, opt) = value;
+    else
     {
+        char *end = nullptr;
+        const unsigned long n = strtoul(value.c_str(), &end, 10);
+        if (value.empty() || *end || n < def.min || n > def.max)
+        {
+            std::cerr << "Option " << def.key << "=" << value << " is not valid (" << def.min << " to " << def.max << ")" << std::endl;
+            return false;
+        }
+        if (def.type == 'b')
+            *boolOption(*this, opt) = (n != 0);
+        else if (def.type == 'd')
+            _defaultDifficulty = (eGameDiff)n;
+        else
+            *uintOption(*this, opt) = (unsigned int)n;
+    }
+
+    const std::string now = get(opt);
+    if (bSave && def.bSaved && _saved[opt] != now)
+    {
+        _saved[opt] = now;
         _bDirty = true;
-        _defaultWordFile = wordFile;
+        _changedAt = Locator::clock().now();
+        if (!_bSaveQueued)
+        {
+            _bSaveQueued = true;
+            Locator::timers().add(OPTIONS_SAVE_MS, [this]() { return saveTick(); });
+        }
     }
-    return _bDirty;
+    if (now != old)
+    {
+        const std::map<unsigned int, tListener> listeners(_listeners);    //in case one unlistens
+        for (auto &l : listeners)
+            l.second(opt);
+    }
+    return true;
+}
+
+std::string GameOptions::get(eOption opt) const
+{
+    if (opt < 0 || opt >= OPT_MAX) return std::string();
+    switch (s_options[opt].type)
+    {
+    case 'b':   return *boolOption(*this, opt) ? "1" : "0";
+    case 'd':   return std::to_string((int)_defaultDifficulty);
+    case 's':   return *stringOption(*this, opt);
+    default:    return std::to_string(*uintOption(*this, opt));
+    }
+}
+
+//--key=value for any option in the registry (--key alone for 1)
+bool GameOptions::setArg(const std::string &arg)
+{
+    if (arg.compare(0, 2, "--") != 0) return false;
+    const std::string::size_type eq = arg.find('=');
+    const std::string key = arg.substr(2, (eq == std::string::npos) ? std::string::npos : eq - 2);
+    for (int opt = 0; opt < OPT_MAX; ++opt)
+    {
+        if (key == s_options[opt].key)
+        {
+            set((eOption)opt, (eq == std::string::npos) ? "1" : arg.substr(eq + 1), false);
+            return true;
+        }
+    }
+    return false;
+}
+
+void GameOptions::help(std::ostream &out)
+{
+    GameOptions defaults;
+    for (int opt = 0; opt < OPT_MAX; ++opt)
+    {
+        const SOptionDef &def = s_options[opt];
+        out << "  --" << def.key << "=" << (def.type == 's' ? "S" : "N") << "  -  " << def.help
+            << " (default " << defaults.get((eOption)opt) << ")" << std::endl;
+    }
+}
+
+unsigned int GameOptions::listen(tListener fn)
+{
+    _listeners[_nextListener] = fn;
+    return _nextListener++;
+}
+
+void GameOptions::unlisten(unsigned int id)
+{
+    _listeners.erase(id);
+}
+
+bool GameOptions::setDefaultWordFile(const std::string &wordFile)
+{
+    if (_defaultWordFile == wordFile) return false;
+    set(OPT_DEFAULTWORDFILE, wordFile);
+    return true;
 }
 
-//make sure dirty flag set
 void GameOptions::setSingleTap(bool b)
 {
-    if (_bSingleTapMenus != b) _bDirty = true;
-    _bSingleTapMenus = b;
+    set(OPT_SINGLETAP, b ? "1" : "0");
 }
 
-//make sure dirty flag set
 void GameOptions::setDefaultDiff(eGameDiff e)
 {
-    if (_defaultDifficulty != e) _bDirty = true;
-    _defaultDifficulty = e;
+    set(OPT_DEFAULTDIFF, std::to_string((int)e));
 }
 
-//make sure dirty flag set
 void GameOptions::setDefaultSfxOn(bool b)
 {
-    if (_bDefaultSfxOn != b) _bDirty = true;
-    _bDefaultSfxOn = b;
+    set(OPT_DEFAULTSFX, b ? "1" : "0");
 }
 
-//make sure dirty flag set
 void GameOptions::setDefaultMusicOn(bool b)
 {
-    if (_bDefaultMusicOn != b) _bDirty = true;
-    _bDefaultMusicOn = b;
+    set(OPT_DEFAULTMUSIC, b ? "1" : "0");
 }
@@ -16,17 +16,44 @@
 #include "words.h"		//SDL.h should be declared before this
 #include "score.h"
 #include "spritemgr.h"
+#include "personal.h"
+
+#include <functional>
+#include <future>
+#include <map>
 
 #pragma message("defining GameOptions\n")
 
-//loadable game options and set using the options screen
+//the options in the registry (see GameOptions::set()), by their key
+enum eOption { OPT_SINGLETAP, OPT_DEFAULTSFX, OPT_DEFAULTMUSIC, OPT_DEFAULTDIFF,
+               OPT_DEFAULTMUSICDIR, OPT_DEFAULTWORDFILE,
+               OPT_FRAMECAP, OPT_VSYNC, OPT_WORKERS, OPT_IMAGEMB, OPT_AUDIOBUF,
+               OPT_LEVELS, OPT_SKILL, OPT_THINK,
+               OPT_MAX };
+
+//loadable game options and set using the options screen.
+//The options are plain members, so reading one costs nothing. Changing one goes
+//through set(), which checks the value, tells any listeners, and writes the
+//options file on a loader thread once they've stopped changing. Every option
+//in the registry can be given on the command line as --<key>=<value>, which
+//changes it for this run without saving it.
 struct GameOptions
 {
 public:
+    typedef std::function<void(eOption)> tListener;
+
     GameOptions();
     ~GameOptions();
     bool load();
-    bool save();
+    bool save();            //now, if changed
+
+    bool set(eOption opt, const std::string &value, bool bSave = true);   //false if not a valid value
+    std::string get(eOption opt) const;
+    bool setArg(const std::string &arg);    //--key=value, false if not an option
+    static void help(std::ostream &out);
+
+    unsigned int listen(tListener fn);      //called after each change, on the main thread
+    void unlisten(unsigned int id);
 
     void setSingleTap(bool b);
     void setDefaultSfxOn(bool b);
@@ -37,6 +64,22 @@ public:
     //command line options, override default options
     bool        _bSound;    //if false, loads null IAudio
     bool        _bMute;     //true if mute fx and music at startup (cmd line option)
+    bool        _bBake;     //true to write the asset pack after loading, then exit (cmd line option)
+    unsigned int _imageBudgetMB;    //cached images before evicting, 0 = no limit
+    unsigned int _audioBuffer;  //mixer buffer in samples, 0 = platform SOUND_CHUNK
+    bool        _bHeadless;     //no display or sound, scripted input on a virtual clock (cmd line option)
+    std::string _simScript;     //headless input script, empty for the built in one (cmd line option)
+    unsigned int _simLevels;    //headless run stops after this many levels
+    bool        _bBot;          //headless, played by BotInput instead of a script (cmd line option)
+    unsigned int _botSkill;     //bot finds this % of the words
+    unsigned int _botThinkMs;   //bot takes about this long to find each word
+    std::string _recordFile;    //record input to this trace file (cmd line option)
+    std::string _replayFile;    //replay this trace headless (cmd line option)
+
+    //performance
+    unsigned int _frameCap;     //frames a second, 0 = no cap
+    bool        _bVsync;        //wait for the display's refresh (at startup)
+    unsigned int _workerThreads;    //loader threads, 0 = one per core up to 4 (at startup)
 
     //default options, set in the options screen
 	bool        _bSingleTapMenus;
@@ -46,8 +89,20 @@ public:
 	std::string _defaultMusicDir;   //"music"
 	eGameDiff   _defaultDifficulty; //0,1,or 2 (easy, med or hard)
 private:
+    GameOptions(const GameOptions &) = delete;
+    GameOptions & operator=(const GameOptions &) = delete;
+
+    std::string text() const;       //the options file
+    Uint32      saveTick();         //timer, writes the file once changes have settled
+
     bool        _bDirty;
     std::string _optionsFile;
+    std::string _saved[OPT_MAX];    //values to write, so command line ones aren't
+    std::map<unsigned int, tListener> _listeners;
+    unsigned int _nextListener;
+    bool        _bSaveQueued;       //saveTick() timer running
+    Uint32      _changedAt;         //game time of the last change
+    std::future<bool> _write;
 };
 
 //to persist global data throughout app
@@ -58,15 +113,21 @@ public:
 	GameData(GameOptions &opt);
 	~GameData();
 
-    void setOptions(const GameOptions &opt) { _options = opt; }
 	void init();
 
 	bool isLoaded() {return _init;}
 	void setDiffLevel(eGameDiff newDiff);
 
-	void saveQuickState();
+	//game state plus, if level._bLevel, the level part played. Written in the background
+	void saveQuickState(const tQuickStateSave &level = tQuickStateSave());
+	void deleteQuickState();
 	bool loadQuickState();
 
+	void savePersonalWords();	//_unmatchedWords to the personal log
+	void flush();				//wait for the quick save and personal words being written
+
+	Uint32 dailyChallengeKey();	//today's, for Words::setChallenge()
+
 	//Resources - not in resource handler
 	/////////////////////////////////////
 
@@ -77,24 +138,13 @@ public:
 	FontTTF _fntMed;
 	FontTTF _fntBig;
 
-	//sound effectes etc
-	Mix_Chunk *_fxCountdown;	//countdown ping noise
-	Mix_Chunk *_fxBadword;		//word not in dictionary noise
-	Mix_Chunk *_fxOldword;		//word already found and now shown in list
-	Mix_Chunk *_fx6notfound;	//6 letter word not found after timeout
-	Mix_Chunk *_fx6found;		//6 letter word found
-	Mix_Chunk *_fxFound;		//non 6 letter word found
-	Mix_Chunk *_fxBonus;		//all words found in time
-	Mix_Chunk *_fxWoosh;		//jumble letters sound
-	Mix_Chunk *_fxRoundel;		//roundel press
-	Mix_Chunk *_fxControl;		//control press
-
+	//music (sound effects are in Audio, by AUDIO_SFX_ id)
 	Mix_Music *_musicMenu;		//menu music, fades in game
 
 	//Game vars
 	///////////////////////////////
 
-    GameOptions _options;
+    GameOptions &_options;     //main()'s, so changes are seen (and listened for) everywhere
 
 	int			_mainmenuoption;	// (0=play, 1=level, 2=hiscore etc)
 
@@ -104,6 +154,7 @@ public:
 
 	eGameState	_state;		//state of play...
 	eGameMode	_mode;		//type of game
+	Uint32		_challenge;	//daily challenge key, 0 for the shuffled word list
 
 	Score		_score;
 	Words		_words;		//The one instance of the main word manipulation class
@@ -111,6 +162,7 @@ public:
 	float		_fact;		//frame rate speed factor
 
 	tWordSet 	_unmatchedWords;	//set of words tested but not matching any in dict
+	PersonalWords	_personal;		//and the log of them, kept across games
 
 	int 		_current_h;			//used to store screen height as SDL_VideoInfo current_w not available in my build
 	int			_current_w;			//used to store screen width
@@ -120,8 +172,14 @@ public:
 
     SpriteMgr   _effects;       //sprite effects used in main game loop
 
+	tQuickStateSave	_resume;	//level to pick up part way through, after loadQuickState()
+
 private:
+	void		optionChanged(eOption opt);
+
 	bool		_init;
+	unsigned int	_optionsListener;	//reloads the words when the word file is changed
+	std::future<bool>	_qsWrite;	//quick save being written
 
 };
 
@@ -50,5 +50,9 @@ const int COUNTDOWN_TIMETRIAL	= 120;
 #define USER_EV_CONTROL_TOUCH           15
 #define USER_EV_CONTROL_TAP             16
 
+//windowID of key events pushed by the game itself. Not recorded in a trace
+//as replaying the game makes them again
+#define GAME_KEY_WINDOW_ID              0xFFFFFFFF
+
 #endif //_GAME_GLOBAL_H_
 
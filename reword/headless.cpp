@@ -0,0 +1,350 @@
+////////////////////////////////////////////////////////////////////
+/*
+
+File:			headless.cpp
+
+Class impl:		ScriptInput, SimStats
+
+Description:	Drive the game from a script with no display or sound, stepping
+				a virtual clock one frame at a time with no frame cap, and time
+				each frame's work and render so we can see what the game itself
+				costs rather than what the display and vsync cost.
+				The built in script plays SpeedWord, typing each target word as
+				soon as the level starts, for as many levels as asked.
+
+Licence:		This program is free software; you can redistribute it and/or modify
+				it under the terms of the GNU General Public License as published by
+				the Free Software Foundation; either version 2 of the License, or
+				(at your option) any later version.
+
+				This software is distributed in the hope that it will be useful,
+				but WITHOUT ANY WARRANTY; without even the implied warranty of
+				MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+				GNU General Public License for more details.
+
+				You should have received a copy of the GNU General Public License
+				along with this program; if not, write to the Free Software
+				Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+////////////////////////////////////////////////////////////////////
+
+#include "headless.h"
+#include "locator.h"
+#include "easing.h"
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#define KEY_HOLD_MS		50		//key down to key up
+#define KEY_GAP_MS		100		//key down to next key down
+
+static const char *_defaultScript =
+	"0    mode 2       # SpeedWord, one all-letter word per level\n"
+	"1000 key Return   # main menu - Play\n"
+	"1000 key Return   # mode menu - SpeedWord\n"
+	"begin\n"
+	"1500 target       # once the letters have slid in\n"
+	"1000 key Return   # past the level end to the next word\n"
+	"loop\n";
+
+ScriptInput::ScriptInput() : _next(0), _begin(0), _due(0), _tried(0)
+{
+}
+
+bool ScriptInput::load(const std::string &fileName)
+{
+	_script.clear();
+	_next = _begin = 0;
+	_due = 0;
+	_queued.clear();
+
+	if (fileName.empty())
+	{
+		std::istringstream in(_defaultScript);
+		return parse(in);
+	}
+
+	std::ifstream in(fileName.c_str());
+	if (!in)
+	{
+		std::cerr << "Unable to open script " << fileName << std::endl;
+		return false;
+	}
+	std::cout << "Using script " << fileName << std::endl;
+	return parse(in);
+}
+
+bool ScriptInput::parse(std::istream &in)
+{
+	std::string line;
+	int lineNo = 0;
+	while (std::getline(in, line))
+	{
+		++lineNo;
+		line = line.substr(0, line.find('#'));
+		std::istringstream ss(line);
+		SCommand c;
+		c.delay = 0;
+		c.x = c.y = 0;
+		ss >> std::ws;
+		if (ss.eof()) continue;		//blank or comment
+		if (std::isdigit(ss.peek()))
+			ss >> c.delay;
+		if (!(ss >> c.cmd))
+		{
+			std::cerr << "Script line " << lineNo << ": missing command" << std::endl;
+			return false;
+		}
+
+		bool bOk = true;
+		if ("key" == c.cmd)
+			bOk = (ss >> c.arg) && SDL_GetKeyFromName(c.arg.c_str()) != SDLK_UNKNOWN;
+		else if ("type" == c.cmd)
+			bOk = !!(ss >> c.arg);
+		else if ("tap" == c.cmd || "mode" == c.cmd)
+			bOk = !!(ss >> c.x) && ("mode" == c.cmd || (ss >> c.y));
+		else
+			bOk = ("target" == c.cmd || "begin" == c.cmd || "loop" == c.cmd || "quit" == c.cmd);
+
+		if (!bOk)
+		{
+			std::cerr << "Script line " << lineNo << ": bad command '" << line << "'" << std::endl;
+			return false;
+		}
+		_script.push_back(c);
+	}
+	return true;
+}
+
+Uint32 ScriptInput::queueKey(SDL_Keycode key, Uint32 when)
+{
+	SDL_Event event;
+	SDL_zero(event);
+	event.key.keysym.sym = key;
+
+	event.type = SDL_KEYDOWN;
+	event.key.state = SDL_PRESSED;
+	_queued.push_back(std::make_pair(when, event));
+
+	event.type = SDL_KEYUP;
+	event.key.state = SDL_RELEASED;
+	_queued.push_back(std::make_pair(when + KEY_HOLD_MS, event));
+
+	return when + KEY_GAP_MS;
+}
+
+Uint32 ScriptInput::queueType(const std::string &letters, Uint32 when)
+{
+	for (auto ch : letters)
+		if (std::isalpha((unsigned char)ch))
+			when = queueKey(SDLK_a + (std::tolower((unsigned char)ch) - 'a'), when);
+	return when;
+}
+
+Uint32 ScriptInput::queueWord(const std::string &word, Uint32 when)
+{
+	++_tried;
+	return queueKey(SDLK_RETURN, queueType(word, when));
+}
+
+Uint32 ScriptInput::run(const SCommand &c, Uint32 now)
+{
+	if ("key" == c.cmd)
+		return queueKey(SDL_GetKeyFromName(c.arg.c_str()), now);
+	if ("type" == c.cmd)
+		return queueType(c.arg, now);
+	if ("target" == c.cmd)
+		return queueWord(Locator::data()._words.getWordTarget(), now);
+	if ("tap" == c.cmd)
+	{
+		SDL_Event event;
+		SDL_zero(event);
+		event.button.button = SDL_BUTTON_LEFT;
+		event.button.x = c.x;
+		event.button.y = c.y;
+		event.type = SDL_MOUSEBUTTONDOWN;
+		event.button.state = SDL_PRESSED;
+		_queued.push_back(std::make_pair(now, event));
+		event.type = SDL_MOUSEBUTTONUP;
+		event.button.state = SDL_RELEASED;
+		_queued.push_back(std::make_pair(now + KEY_HOLD_MS, event));
+		return now + KEY_GAP_MS;
+	}
+	if ("mode" == c.cmd)
+		Locator::data()._mode = (eGameMode)c.x;
+	else if ("begin" == c.cmd)
+		_begin = _next;		//already moved past this line
+	else if ("loop" == c.cmd)
+		_next = _begin;
+	else if ("quit" == c.cmd)
+		_next = _script.size();
+	return now;
+}
+
+void ScriptInput::feed(Uint32 now)
+{
+	//run every command now due, each one's delay counting from the end of the last
+	if (!_due && _next < _script.size()) _due = now + _script[_next].delay;
+	//(at most one pass of the script per frame, so a loop with no delays can't spin)
+	for (size_t n = 0; n < _script.size() && _next < _script.size() && now >= _due; ++n)
+	{
+		const SCommand &c = _script[_next++];
+		const Uint32 end = run(c, _due);
+		if (_next < _script.size())
+			_due = end + _script[_next].delay;
+	}
+	pushDue(now);
+}
+
+void ScriptInput::pushDue(Uint32 now)
+{
+	while (!_queued.empty() && now >= _queued.front().first)
+	{
+		SDL_PushEvent(&_queued.front().second);
+		_queued.pop_front();
+	}
+}
+
+
+SimStats::SimStats() :
+	_freq(SDL_GetPerformanceFrequency()),
+	_runStart(SDL_GetPerformanceCounter()), _frameStart(0), _workEnd(0), _screenStart(0),
+	_virtualStart(0), _levels(0)	//the game's clock isn't registered yet, see screenReady()
+{
+}
+
+Uint32 SimStats::since(Uint64 start) const
+{
+	return (Uint32)((SDL_GetPerformanceCounter() - start) * 1000000 / _freq);
+}
+
+void SimStats::startFrame()
+{
+	_frameStart = SDL_GetPerformanceCounter();
+}
+
+void SimStats::endWork()
+{
+	_workEnd = SDL_GetPerformanceCounter();
+	_work.push_back((Uint32)((_workEnd - _frameStart) * 1000000 / _freq));
+}
+
+void SimStats::endFrame(const std::string &target)
+{
+	_render.push_back(since(_workEnd));
+	checkLevel(target, since(_frameStart));
+}
+
+void SimStats::screenStart()
+{
+	_screenStart = SDL_GetPerformanceCounter();
+}
+
+void SimStats::screenReady(const std::string &target)
+{
+	if (!_virtualStart) _virtualStart = Locator::clock().now();	//never 0 once stamped
+	const Uint32 us = since(_screenStart);
+	_screens.push_back(us);
+	checkLevel(target, us);	//a game screen starts its first level in init()
+}
+
+//the target word only changes when a new level starts, so its frame (or the
+//screen init) holds the whole level transition
+void SimStats::checkLevel(const std::string &target, Uint32 us)
+{
+	if (target == _target) return;
+	_target = target;
+	if (target.empty()) return;
+	++_levels;
+	_levelTimes.push_back(us);
+}
+
+static void printTimes(const char *name, std::vector<Uint32> v)
+{
+	if (v.empty())
+	{
+		std::cout << "  " << std::setw(10) << name << ": none" << std::endl;
+		return;
+	}
+	std::sort(v.begin(), v.end());
+	double total = 0;
+	for (auto us : v) total += us;
+	std::cout << "  " << std::setw(10) << name << ": " << std::setw(6) << v.size()
+		<< "  avg " << std::setw(8) << total / v.size() / 1000.0 << "ms"
+		<< "  p95 " << std::setw(8) << v[v.size() * 95 / 100] / 1000.0 << "ms"
+		<< "  max " << std::setw(8) << v.back() / 1000.0 << "ms" << std::endl;
+}
+
+void SimStats::report(unsigned int words) const
+{
+	const double wallSecs = since(_runStart) / 1000000.0;
+	const double gameSecs = _virtualStart ? (Locator::clock().now() - _virtualStart) / 1000.0 : 0;
+
+	std::cout << std::fixed << std::setprecision(3)
+		<< "Headless run: " << _render.size() << " frames, " << _levels << " levels, "
+		<< gameSecs << "s game time in " << wallSecs << "s ("
+		<< (wallSecs > 0 ? _levels / wallSecs : 0) << " levels/s, "
+		<< words << " words tried, " << (wallSecs > 0 ? words / wallSecs : 0) << " words/s)" << std::endl;
+	printTimes("work", _work);
+	printTimes("render", _render);
+	printTimes("screen", _screens);
+	printTimes("level", _levelTimes);
+}
+
+
+void benchEasing()
+{
+	const int frames = 100;
+	const int curves = Easing::EASE_MAX;
+	const Uint64 freq = SDL_GetPerformanceFrequency();
+	volatile float sink = 0;	//so the work isn't optimised away
+
+	std::cout << std::fixed << std::setprecision(1);
+	for (size_t n : { (size_t)1000, (size_t)10000 })
+	{
+		//one at a time, as each sprite worked its own tweens before
+		struct STween { Easing::eType ease; float t, b, c, d; };
+		std::vector<STween> each(n);
+		for (size_t i = 0; i < n; ++i)
+		{
+			STween e = { (Easing::eType)(i % curves), 0, (float)(i % 320), (float)(i % 200) - 100, 2000 };
+			each[i] = e;
+		}
+
+		Uint64 start = SDL_GetPerformanceCounter();
+		for (int f = 0; f < frames; ++f)
+			for (auto &e : each)
+			{
+				e.t += 16;
+				sink = sink + e.b + e.c * Easing::curve(e.ease, std::min(e.t / e.d, 1.0f));
+			}
+		const double perTween = (SDL_GetPerformanceCounter() - start) * 1e9 / freq / frames / n;
+
+		//the same tweens in the store the sprites use, ticked and read back
+		//each frame as Game and Sprite::work() do
+		Easing batch;
+		std::vector<Easing::tEaseId> ids(n);
+		for (size_t i = 0; i < n; ++i)
+			ids[i] = batch.add((Easing::eType)(i % curves), (float)(i % 320), (float)(i % 200) - 100, 2000);
+
+		Uint32 now = Locator::clock().now();
+		start = SDL_GetPerformanceCounter();
+		for (int f = 0; f < frames; ++f)
+		{
+			batch.tick(now += 16);
+			for (auto id : ids)
+				sink = sink + batch.value(id);
+		}
+		const double batched = (SDL_GetPerformanceCounter() - start) * 1e9 / freq / frames / n;
+
+		std::cout << "Easing " << std::setw(5) << n << " tweens: "
+			<< std::setw(6) << perTween << "ns each one at a time, "
+			<< std::setw(6) << batched << "ns each by Easing::tick() and value()" << std::endl;
+	}
+	std::cout.unsetf(std::ios::floatfield);
+}
@@ -0,0 +1,104 @@
+//headless.h
+//
+//Scripted input and timing stats for running the game without a display,
+//eg. "reword -headless -levels 50" in CI to catch gameplay slowdowns.
+
+#if !defined HEADLESS_H
+#define HEADLESS_H
+
+#include <SDL.h>
+
+#include "input.h"
+
+#include <deque>
+#include <string>
+#include <vector>
+
+//Input that also feeds key and mouse events from a script into the SDL event
+//queue, so they go through the normal Game::play() event handling.
+//Each script line is "<delay ms> <command> [args]", the delay counting from
+//the end of the previous command:
+//	key <name>		press and release a key (SDL key name, eg. Return, Escape, a)
+//	type <letters>	press and release each letter in turn
+//	target			type the current target word then Return
+//	tap <x> <y>		press and release the mouse at x,y
+//	mode <n>		set the game mode the mode menu starts on (0..3, see eGameMode)
+//	begin			mark where 'loop' jumps back to
+//	loop			go back to the last 'begin'
+//	quit			end the run (as does reaching the end of the script)
+//Anything after a # is a comment.
+class ScriptInput : public Input
+{
+public:
+	ScriptInput();
+	virtual ~ScriptInput() {}
+
+	bool load(const std::string &fileName);	//empty name for the built in script
+	virtual void feed(Uint32 now);			//push any events due by now
+	virtual bool finished() const { return _next >= _script.size() && _queued.empty(); }
+	unsigned int tried() const { return _tried; }	//words typed in and submitted
+
+protected:
+	struct SCommand
+	{
+		Uint32		delay;
+		std::string	cmd;
+		std::string	arg;
+		int			x, y;
+	};
+
+	bool parse(std::istream &in);
+	Uint32 run(const SCommand &c, Uint32 now);	//returns the time its events end
+	Uint32 queueKey(SDL_Keycode key, Uint32 when);
+	Uint32 queueType(const std::string &letters, Uint32 when);
+	Uint32 queueWord(const std::string &word, Uint32 when);	//type it then Return
+	void pushDue(Uint32 now);
+
+	std::vector<SCommand>	_script;
+	size_t					_next;		//next command to run
+	size_t					_begin;		//where 'loop' goes back to
+	Uint32					_due;		//when the next command runs, 0 = on first feed
+	std::deque<std::pair<Uint32, SDL_Event> > _queued;	//expanded events waiting their time
+	unsigned int			_tried;
+};
+
+//per frame work (update) and render CPU times, plus how long each screen and
+//each new level took to get going
+class SimStats
+{
+public:
+	SimStats();
+
+	void startFrame();
+	void endWork();
+	void endFrame(const std::string &target);	//after render, a new target means a new level
+	void screenStart();							//before a screen (IPlay) is created
+	void screenReady(const std::string &target);//after its init()
+
+	unsigned int levels() const { return _levels; }
+	void report(unsigned int words) const;		//words submitted, for words/s
+
+private:
+	void checkLevel(const std::string &target, Uint32 us);
+	Uint32 since(Uint64 start) const;	//us
+
+	Uint64		_freq;
+	Uint64		_runStart;
+	Uint64		_frameStart;
+	Uint64		_workEnd;
+	Uint64		_screenStart;
+	Uint32		_virtualStart;	//game time the first screen was ready, 0 till then
+
+	std::vector<Uint32>	_work;		//all times in us
+	std::vector<Uint32>	_render;
+	std::vector<Uint32>	_screens;
+	std::vector<Uint32>	_levelTimes;
+	std::string			_target;
+	unsigned int		_levels;
+};
+
+//time easing 1k and 10k tweens, one at a time through Easing::curve() vs
+//the Easing store ticked and read back as the sprites use it (reword -benchease)
+void benchEasing();
+
+#endif //HEADLESS_H
@@ -37,6 +37,9 @@ Licence:		This program is free software; you can redistribute it and/or modify
 #include <cctype>
 #include <sstream>
 #include <cstring> 		//for strcasecmp/stricmp etc
+#include <cerrno>
+#include <filesystem>
+#include <fstream>
 #include <vector>
 
 namespace pptxt
@@ -150,3 +153,31 @@ bool splitKeyValuePair(const std::string &line, std::string &key, std::string &v
 
 } //namespace pptxt
 
+namespace ppfile
+{
+
+bool writeFileAtomic(const std::string &fileName, const void *data, size_t len, std::string &error)
+{
+	const std::string tmpfile = fileName + ".tmp";
+	{
+		std::ofstream out(tmpfile.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+		out.write(static_cast<const char*>(data), len);
+		out.close();
+		if (!out)
+		{
+			error = "can't write " + tmpfile + " - " + strerror(errno);
+			return false;
+		}
+	}
+	std::error_code ec;
+	std::filesystem::rename(tmpfile, fileName, ec);	//replaces the old one in one step
+	if (ec)
+	{
+		error = "can't replace " + fileName + " - " + ec.message();
+		return false;
+	}
+	return true;
+}
+
+} //namespace ppfile
+
@@ -23,4 +23,13 @@ namespace pptxt	//pp string functions
 
 }
 
+namespace ppfile	//pp file functions
+{
+
+	//write to fileName.tmp then rename it over fileName, so an exit part way
+	//through never leaves half a file. false with the reason in error if not
+	bool writeFileAtomic(const std::string &fileName, const void *data, size_t len, std::string &error);
+
+}
+
 #endif //HELPERS_H
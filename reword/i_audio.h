@@ -7,9 +7,15 @@
 class IAudio
 {
 public:
+    //who gets a mixer channel when they're all busy. Each level has its own
+    //channels and only ever steals from itself, so a burst of roundel presses
+    //can't cut off the countdown ping
+    enum eSfxPriority { SFX_PRI_LOW, SFX_PRI_NORMAL, SFX_PRI_HIGH, SFX_PRI_MAX };
+
     IAudio() {}
 	virtual ~IAudio() {}
 
+    virtual void setBufferSize(int samples) = 0;   //before setup(), 0 for the platform default
 	virtual void setup(bool bSfx, bool bMusic, const std::string &baseTrackDir, bool bMute) = 0;
 	virtual void closedown() = 0;
 
@@ -48,7 +54,7 @@ public:
 	virtual bool isPlayingMusic() = 0;
 	virtual bool isActuallyPlayingMusic() = 0;
 
-    virtual int addSfx(const std::string &, unsigned int) = 0;
+    virtual int addSfx(const std::string &, unsigned int, eSfxPriority = SFX_PRI_NORMAL) = 0;
 	virtual void playSfx(unsigned int, unsigned int = 0) = 0;
 	virtual void playSfx(const std::string &, unsigned int = 0) = 0;
 };
@@ -149,6 +149,19 @@ bool Image::create(unsigned int w, unsigned int h, Uint32 nTiles /*=1*/, SDL_Col
     return bOk;
 }
 
+//an image the renderer draws into (eg. prerendered backgrounds)
+bool Image::createTarget(unsigned int w, unsigned int h)
+{
+    cleanUp();
+    _ptex = std::shared_ptr<Texture>(new Texture());
+    if (_ptex->createTarget(w, h))
+    {
+        _init = true;
+        setTileCount(1);
+    }
+    return _init;
+}
+
 //create this image from another image or part image (tile)
 void Image::cloneFrom(Image &image, int iAlpha /*=-1*/)
 {
@@ -44,6 +44,7 @@ public:
 //    }
 
     bool create(unsigned int w, unsigned int h, Uint32 nTiles = 1, SDL_Color cAlphaKey = ALPHA_COLOUR, Uint8 iAlpha = 255);
+    bool createTarget(unsigned int w, unsigned int h);  //render target, see Screen::setTarget()
 	bool initDone() const { return _init; }	//has Image been initialised properly
     Texture * texture() const { return _ptex.get(); }
 
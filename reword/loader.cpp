@@ -0,0 +1,199 @@
+////////////////////////////////////////////////////////////////////
+/*
+
+File:			loader.cpp
+
+Class impl:		AsyncLoader
+
+Description:	Worker threads to decode png images, load wav sound effects and
+				parse the dictionary while the splash screen is up. Anything queued
+				is handed over when the main thread asks for it (waiting only if that
+				particular item isn't ready yet), so startup takes about as long as
+				the slowest single asset rather than the sum of them all.
+				Textures still have to be created on the main (render) thread, so
+				only the decoding is done here.
+
+Licence:		This program is free software; you can redistribute it and/or modify
+				it under the terms of the GNU General Public License as published by
+				the Free Software Foundation; either version 2 of the License, or
+				(at your option) any later version.
+
+				This software is distributed in the hope that it will be useful,
+				but WITHOUT ANY WARRANTY; without even the implied warranty of
+				MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+				GNU General Public License for more details.
+
+				You should have received a copy of the GNU General Public License
+				along with this program; if not, write to the Free Software
+				Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+////////////////////////////////////////////////////////////////////
+
+#include "loader.h"
+
+#include <SDL_image.h>	//for IMG_ functions
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+
+AsyncLoader::AsyncLoader() : _bStop(false)
+{
+}
+
+AsyncLoader::~AsyncLoader()
+{
+    stop();
+}
+
+void AsyncLoader::start(unsigned int nThreads /*= 0*/)
+{
+    if (!_threads.empty()) return;  //already running
+
+    if (nThreads == 0)
+        nThreads = std::min(std::max(std::thread::hardware_concurrency(), 1u), 4u);
+
+    _bStop = false;
+    for (unsigned int i = 0; i < nThreads; ++i)
+        _threads.push_back(std::thread(&AsyncLoader::worker, this));
+}
+
+void AsyncLoader::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _bStop = true;
+    }
+    _jobReady.notify_all();
+    for (auto &t : _threads)
+        t.join();
+    _threads.clear();
+
+    //anything decoded but never asked for
+    for (auto &it : _images)
+        SDL_FreeSurface(it.second);
+    _images.clear();
+    for (auto &it : _sounds)
+        Mix_FreeChunk(it.second);
+    _sounds.clear();
+    _pending.clear();
+    _discard.clear();
+}
+
+void AsyncLoader::worker()
+{
+    for (;;)
+    {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _jobReady.wait(lock, [this] { return _bStop || !_jobs.empty(); });
+            if (_jobs.empty())
+                return;     //stopping and nothing left to do
+            job = std::move(_jobs.front());
+            _jobs.pop_front();
+        }
+        job();
+    }
+}
+
+//run on a worker, or straight away if there aren't any
+void AsyncLoader::push(std::function<void()> job)
+{
+    if (_threads.empty())
+    {
+        job();
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _jobs.push_back(std::move(job));
+    }
+    _jobReady.notify_one();
+}
+
+void AsyncLoader::queueImage(const std::string &fileName)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _discard.erase(fileName);   //wanted again
+        if (_images.count(fileName) || !_pending.insert(fileName).second)
+            return;     //already queued
+    }
+    push([this, fileName]()
+    {
+        SDL_Surface *s = IMG_Load(fileName.c_str());
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (s && _discard.erase(fileName))
+            SDL_FreeSurface(s);
+        else if (s)
+            _images[fileName] = s;
+        _pending.erase(fileName);
+        _jobDone.notify_all();
+    });
+}
+
+void AsyncLoader::queueSound(const std::string &fileName)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_sounds.count(fileName) || !_pending.insert(fileName).second)
+            return;     //already queued
+    }
+    push([this, fileName]()
+    {
+        Mix_Chunk *c = Mix_LoadWAV(fileName.c_str());
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (c) _sounds[fileName] = c;
+        _pending.erase(fileName);
+        _jobDone.notify_all();
+    });
+}
+
+std::future<bool> AsyncLoader::queueJob(std::function<bool()> job)
+{
+    auto task = std::make_shared<std::packaged_task<bool()>>(std::move(job));
+    std::future<bool> result = task->get_future();
+    push([task]() { (*task)(); });
+    return result;
+}
+
+template<typename T> T * AsyncLoader::take(std::map<std::string, T *> &done, const std::string &fileName)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    _jobDone.wait(lock, [this, &fileName] { return _pending.count(fileName) == 0; });
+
+    auto it = done.find(fileName);
+    if (it == done.end())
+        return nullptr;
+    T *p = it->second;
+    done.erase(it);     //caller owns it now
+    return p;
+}
+
+SDL_Surface * AsyncLoader::takeImage(const std::string &fileName)
+{
+    return take(_images, fileName);
+}
+
+Mix_Chunk * AsyncLoader::takeSound(const std::string &fileName)
+{
+    return take(_sounds, fileName);
+}
+
+void AsyncLoader::discardImages(const std::set<std::string> &fileNames)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto &fileName : fileNames)
+    {
+        auto it = _images.find(fileName);
+        if (it != _images.end())
+        {
+            SDL_FreeSurface(it->second);
+            _images.erase(it);
+        }
+        else if (_pending.count(fileName))
+            _discard.insert(fileName);
+    }
+}
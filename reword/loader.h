@@ -0,0 +1,64 @@
+//loader.h
+//
+//Background loading of images, sounds and anything else (the dictionary)
+//on worker threads during startup. Results are collected on the main
+//thread, which does the texture uploads, as and when they are needed.
+
+#if !defined LOADER_H
+#define LOADER_H
+
+#include <SDL.h>
+#include <SDL_mixer.h>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+class AsyncLoader
+{
+public:
+    AsyncLoader();
+    ~AsyncLoader();
+
+    void start(unsigned int nThreads = 0);  //0 = one per core (up to 4)
+    void stop();                            //waits for queued jobs, frees anything not taken
+
+    //decode on a worker. Without any workers (not started) these run immediately
+    void queueImage(const std::string &fileName);
+    void queueSound(const std::string &fileName);
+    std::future<bool> queueJob(std::function<bool()> job);
+
+    //hand over a decoded result, waiting for it if still in progress.
+    //nullptr if never queued (or failed) so the caller just loads it itself
+    SDL_Surface * takeImage(const std::string &fileName);
+    Mix_Chunk * takeSound(const std::string &fileName);
+
+    //free these images if decoded but not taken, or once they are if still in progress
+    void discardImages(const std::set<std::string> &fileNames);
+
+protected:
+    void worker();
+    void push(std::function<void()> job);
+    template<typename T> T * take(std::map<std::string, T *> &done, const std::string &fileName);
+
+    std::vector<std::thread>            _threads;
+    std::deque<std::function<void()>>   _jobs;
+    std::mutex                          _mutex;
+    std::condition_variable             _jobReady;
+    std::condition_variable             _jobDone;
+    bool                                _bStop;
+
+    std::set<std::string>               _pending;   //queued but not finished
+    std::set<std::string>               _discard;   //pending images no longer wanted
+    std::map<std::string, SDL_Surface *> _images;
+    std::map<std::string, Mix_Chunk *>  _sounds;
+};
+
+#endif //LOADER_H
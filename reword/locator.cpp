@@ -127,3 +127,89 @@ void Locator::registerData(GameData* data)
         _data = data;
 }
 
+
+//////////////////////////////// CLOCK /////////////////////////////
+
+static Clock _nullclock;    //never stamped
+static Clock * _clock = &_nullclock;
+
+Clock& Locator::clock()
+{
+    return *_clock;
+}
+void Locator::registerClock(Clock* clock)
+{
+    if (clock == nullptr)
+        _clock = &_nullclock;   // revert to null service
+    else
+        _clock = clock;
+}
+
+
+//////////////////////////////// TRACE /////////////////////////////
+
+static Trace _nulltrace;    //neither recording or replaying
+static Trace * _trace = &_nulltrace;
+
+Trace& Locator::trace()
+{
+    return *_trace;
+}
+void Locator::registerTrace(Trace* trace)
+{
+    if (trace == nullptr)
+        _trace = &_nulltrace;   // revert to null service
+    else
+        _trace = trace;
+}
+
+//////////////////////////////// TIMERS /////////////////////////////
+
+static TimerWheel _nulltimers;  //not ticked by anything
+static TimerWheel * _timers = &_nulltimers;
+
+TimerWheel& Locator::timers()
+{
+    return *_timers;
+}
+void Locator::registerTimers(TimerWheel* timers)
+{
+    if (timers == nullptr)
+        _timers = &_nulltimers;   // revert to null service
+    else
+        _timers = timers;
+}
+
+//////////////////////////////// EASING /////////////////////////////
+
+static Easing _nulleasing;  //not ticked by anything
+static Easing * _easing = &_nulleasing;
+
+Easing& Locator::easing()
+{
+    return *_easing;
+}
+void Locator::registerEasing(Easing* easing)
+{
+    if (easing == nullptr)
+        _easing = &_nulleasing;   // revert to null service
+    else
+        _easing = easing;
+}
+
+//////////////////////////////// RANDOM /////////////////////////////
+
+static RandomStreams _nullrandom;   //seeded differently each run
+static RandomStreams * _random = &_nullrandom;
+
+RandomStreams& Locator::random()
+{
+    return *_random;
+}
+void Locator::registerRandom(RandomStreams* random)
+{
+    if (random == nullptr)
+        _random = &_nullrandom;   // revert to null service
+    else
+        _random = random;
+}
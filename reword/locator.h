@@ -10,6 +10,11 @@
 #include "image.h"
 #include "resource.h"
 #include "gamedata.h"
+#include "clock.h"
+#include "trace.h"
+#include "timerwheel.h"
+#include "easing.h"
+#include "random.h"
 
 #include <cassert>
 
@@ -41,6 +46,31 @@ public:
     static GameData&  data();
     static void     registerData(GameData* data);
 
+//CLOCK (game time, only moves when stamped)
+public:
+    static Clock&   clock();
+    static void     registerClock(Clock* clock);
+
+//TRACE (input record/replay, does nothing unless registered)
+public:
+    static Trace&   trace();
+    static void     registerTrace(Trace* trace);
+
+//TIMERS (main loop timers, never fire unless registered)
+public:
+    static TimerWheel&  timers();
+    static void     registerTimers(TimerWheel* timers);
+
+//EASING (sprite tweens, never move unless registered)
+public:
+    static Easing&  easing();
+    static void     registerEasing(Easing* easing);
+
+//RANDOM (a seeded generator for each subsystem, see random.h)
+public:
+    static RandomStreams&   random();
+    static void     registerRandom(RandomStreams* random);
+
 };
 
 
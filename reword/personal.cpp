@@ -0,0 +1,117 @@
+////////////////////////////////////////////////////////////////////
+/*
+
+File:			personal.cpp
+
+Class impl:		PersonalWords
+
+Description:	The player's personal word log. Words tried in play that aren't in
+				the dictionary are appended as '#WORD' candidates at the end of
+				each level, and as 'WORD' once tried again in a later game. The
+				accepted words are only accepted when tried (see Words::setPersonal())
+				and never needed or scored. They count once built into a word list.
+
+Licence:		This program is free software; you can redistribute it and/or modify
+				it under the terms of the GNU General Public License as published by
+				the Free Software Foundation; either version 2 of the License, or
+				(at your option) any later version.
+
+				This software is distributed in the hope that it will be useful,
+				but WITHOUT ANY WARRANTY; without even the implied warranty of
+				MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+				GNU General Public License for more details.
+
+				You should have received a copy of the GNU General Public License
+				along with this program; if not, write to the Free Software
+				Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+////////////////////////////////////////////////////////////////////
+
+#include "personal.h"
+#include "helpers.h"
+#include "resource.h"
+
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+PersonalWords::PersonalWords()
+{
+}
+
+PersonalWords::~PersonalWords()
+{
+	flush();
+}
+
+bool PersonalWords::open(const std::string &fileName)
+{
+	flush();
+	_fileName = fileName;
+	_candidates.clear();
+	_captured.clear();
+	_accepted.clear();
+
+	std::ifstream in(_fileName.c_str());
+	if (!in.is_open())
+		return false;	//nothing logged yet
+
+	std::string line;
+	while (std::getline(in, line))
+	{
+		pptxt::trim(line, " \r\n\t");
+		if (line.empty()) continue;
+		if (line[0] == '#')
+			_candidates.insert(line.substr(1));
+		else
+			_accepted.insert(line);
+	}
+	for (auto &w : _accepted)
+		_candidates.erase(w);
+
+	std::cout << "Personal words: " << _accepted.size() << " accepted, "
+		<< _candidates.size() << " tried" << std::endl;
+	return true;
+}
+
+void PersonalWords::capture(const tWordSet &words)
+{
+	if (_fileName.empty()) return;
+
+	std::vector<std::string> lines;
+	for (auto &w : words)
+	{
+		if (_accepted.count(w)) continue;
+		if (_candidates.count(w))
+		{
+			//tried in an earlier game too, so it's the player's word now
+			_candidates.erase(w);
+			_accepted.insert(w);
+			lines.push_back(w);
+		}
+		else if (_captured.insert(w).second)
+			lines.push_back("#" + w);
+	}
+	if (lines.empty()) return;
+
+	flush();	//keep the batches in order
+	const std::string fileName = _fileName;
+	_write = Resource::loader().queueJob([fileName, lines]()
+	{
+		std::ofstream out(fileName.c_str(), std::ios::out | std::ios::app);
+		for (auto &l : lines)
+			out << l << std::endl;
+		if (!out)
+		{
+			std::cerr << "Cannot write personal words to " << fileName << std::endl;
+			return false;
+		}
+		return true;
+	});
+}
+
+void PersonalWords::flush()
+{
+	if (_write.valid()) _write.wait();
+}
@@ -0,0 +1,38 @@
+//personal.h
+//
+//The player's own words - ones tried that aren't in the dictionary. Each is
+//logged once as a '#' candidate line, and again as a plain WORD line if it's
+//tried again in a later game, which accepts it. The log is only ever
+//appended to, a batch at a time on a loader thread, and as the candidate
+//lines are skipped by any word list reader it can be given straight to
+//rewordlist as a .include file.
+
+#if !defined PERSONAL_H
+#define PERSONAL_H
+
+#include "words.h"
+
+#include <future>
+#include <string>
+
+class PersonalWords
+{
+public:
+	PersonalWords();
+	~PersonalWords();
+
+	bool		open(const std::string &fileName);	//read the log, ok to call from a loader thread
+	void		capture(const tWordSet &words);		//log any new ones, in the background
+	void		flush();							//wait for the last batch to be written
+
+	const tWordSet &	accepted() const { return _accepted; }
+
+private:
+	std::string	_fileName;
+	tWordSet	_candidates;	//logged as a candidate before this game
+	tWordSet	_captured;		//logged as a candidate this game, so not accepted till the next
+	tWordSet	_accepted;
+	std::future<bool>	_write;
+};
+
+#endif //PERSONAL_H
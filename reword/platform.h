@@ -69,6 +69,7 @@
 #define MAX_WORD_COL	8	//max number of words to display down a 3, 4, 5 or 6 word column
 #define MAX_WORD_ROW	4	//4 across screen, 3,4,5,6 for 6, or 5,6,7,8 for 8 letter target word
 #define FOUND_WORD_CHR	10	//pixels wide for calculating found word box size
+#define IMAGE_BUDGET_MB	8	//cached image memory before least recently used are evicted
 
 #elif defined (PANDORA)
 //OpenPandora UMPC
@@ -109,6 +110,7 @@
 #define MAX_WORD_COL	8	//max number of words to display down a 3, 4, 5 or 6 word column
 #define MAX_WORD_ROW	4	//4 across screen, 3,4,5,6 for 6, or 5,6,7,8 for 8 letter target word
 #define FOUND_WORD_CHR	18	//pixels wide for calculating found word box size
+#define IMAGE_BUDGET_MB	32	//cached image memory before least recently used are evicted
 
 //#elif defined (WIZ)
 
@@ -152,6 +154,7 @@
 #define MAX_WORD_COL	8	//max number of words to display down a 3, 4, 5 or 6 word column
 #define MAX_WORD_ROW	4	//4 across screen, 3,4,5,6 for 6, or 5,6,7,8 for 8 letter target word
 #define FOUND_WORD_CHR	18	//pixels wide for calculating found word box size
+#define IMAGE_BUDGET_MB	0	//0 = keep all images cached
 
 #endif
 
@@ -161,6 +164,7 @@
 #define RES_MUSIC       (RES_BASE + std::string("music/"))
 #define RES_SOUNDS      (RES_BASE + std::string("sounds/"))
 #define RES_WORDS       (RES_BASE + std::string("words/"))
+#define RES_ASSETPACK   (RES_BASE + std::string("assets.pak"))   //baked with "reword -bake"
 
 
 //some resources
@@ -62,27 +62,6 @@ Licence:		This program is free software; you can redistribute it and/or modify
 
 //#include <SDL_gfxPrimitives.h>
 
-static	int _countdown;				//seconds remaining
-
-//extern static RandInt g_randInt;
-
-
-//function called when timer reaches interval set
-Uint32 countdown_callback(Uint32 interval, void *param)
-{
-    (void)(param);
-
-	if (_countdown <= 0)
-	{
-		ppg::pushSDL_Event(USER_EV_END_COUNTDOWN); //pushEndOfLevel();
-		return 0;
-	}
-
-	ppg::pushSDL_Event(USER_EV_PING_COUNTDOWN);
-
-	return(interval);
-}
-
 //define static
 Uint32 PlayGame::next_time = 0;
 
@@ -128,7 +107,7 @@ PlayGame::PlayGame(GameData& gd) :
 	_randomTitle = 0;
     _debugTotalLetters = _debugNeededAll = _debugNeededNow = 0;
 
-    _countdown = 0;     //init static var
+    _countdown = 0;
 
 	statePush(PG_PLAY);		//also sets default to PG_PLAY
 }
@@ -147,7 +126,7 @@ void PlayGame::init(Input *input, Screen * scr)
     if (Locator::audio().isPlayingMusic()==false)   //no user music
 		Mix_FadeOutMusic(3000);                     //fade out any menu music
 
-	_scorebar.load("scorebar.png");
+	_scorebar = Resource::image("scorebar.png");
 	_cursor.setImage(Resource::image("cursors.png"));
 	_scratch.setImage(Resource::image("scratch.png"));
 	_boxes.setImage(Resource::image("boxes.png"));
@@ -253,7 +232,7 @@ void PlayGame::init(Input *input, Screen * scr)
 void PlayGame::exit(eGameState toState)
 {
 	stopCountdown();
-	clearEventBuffer();
+	_gd.savePersonalWords();
 	_gd._state = toState;	//ST_MENU, ST_PLAY etc
 //	std::cout << "state: exit = " << toState << std::endl;
 	_running = false;
@@ -351,13 +330,14 @@ void PlayGame::render_play(Screen* s)
 {
 	int xx, yy;
 
-	//draw background
-	s->blit(_gamebg->texture(), nullptr, 0, 0);
+	//draw background (titles and empty word boxes included)
+	if (_gamebg)
+		s->blit(_gamebg->texture(), nullptr, 0, 0);
+	else
+		drawBackground(s);	//no render target support
 
  	//draw scores and coloured seconds countdown
-	_gd._fntClean.put_text(s, _score_x, _score0_y, "SCORE:", BLACK_COLOUR);
 	_gd._fntClean.put_number(s, _score0_x, _score0_y, _gd._score.currScore(), "%08d", GREEN_COLOUR);
-	_gd._fntClean.put_text(s, _words_x, _score0_y, "WORDS:", BLACK_COLOUR);
 	_gd._fntClean.put_number(s, _words0_x, _words0_y, _gd._score.currWords(), "%04d", BLUE_COLOUR);
 	//(>10) normal countdown in "plenty of time" colour
 	//(<=10) countdown in "oh crap" colour (red to denote time running out)
@@ -455,14 +435,15 @@ void PlayGame::render_play(Screen* s)
 					}
 
                     //word for this box could be normal background or in Arcade mode, could be a highlight (green or yellow)
-                    _boxes.blitTo( s, _boxOffset[xx], boxOffsetY,					//tile 0=3, 1=4, 2=5, 3=6 etc. letter words
-                        (
+                    const int tile = (
                             ((PG_PLAY != _state && xx == _xxWordHi && yy == _yyWordHi) || bHighlightWholeColumn) ?
                                 xx+_nWordBoxHighlightOffset :  //xx+(count/4) for n box blocks in boxes.png
                                 (PG_PLAY == _state && _maxwordlen!=_longestWordLen && yy < _boxWordNeeded[xx]) ?
                                     xx+_nWordBoxNeededOffset :      //yellow
                                     xx //+_nWordBoxHighlightOffset     //green
-                        )-3 );  //-3 to reset the xx back to 0 as the boxes.png starts at 3 letter tile
+                        )-3;    //-3 to reset the xx back to 0 as the boxes.png starts at 3 letter tile
+                    if (tile != xx-3)   //plain box already on the background
+                        _boxes.blitTo( s, _boxOffset[xx], boxOffsetY, tile);	//tile 0=3, 1=4, 2=5, 3=6 etc. letter words
 
 					//Display the word in red (not found) or blue (found)
 					//Only found words populate the container during play, so red only drawn at end of level
@@ -476,26 +457,21 @@ void PlayGame::render_play(Screen* s)
                 {
                     //no word for this box so just empty (but possibly highlight for Arcade 'to be found' box)
                     //or show in red if end of level (not in-play)
-                    _boxes.blitTo( s, _boxOffset[xx], boxOffsetY,					//tile 0=3, 1=4, 2=5, 3=6 etc. letter words
-                        (
+                    const int tile = (
                             ((PG_PLAY != _state && xx == _xxWordHi && yy == _yyWordHi) || bHighlightWholeColumn) ?
                                 xx+_nWordBoxHighlightOffset :  //xx+(count/4) for n box blocks in boxes.png
                                 (PG_PLAY == _state && _maxwordlen!=_longestWordLen && yy < _boxWordNeeded[xx]) ?
                                     xx+_nWordBoxNeededOffset :
                                     xx
-                        )-3 );  //-3 to reset the xx back to 0 as the boxes.png starts at 3 letter tile
+                        )-3;    //-3 to reset the xx back to 0 as the boxes.png starts at 3 letter tile
+                    if (tile != xx-3)   //plain box already on the background
+                        _boxes.blitTo( s, _boxOffset[xx], boxOffsetY, tile);
                 }
 
                 ++yy;
 			}
 		}
-		else
-		{
-		    //draw empty rect to denote no words of xx length at all
-            //using sdlGfxPrimitives: rectangleRGBA(s->surface(), _boxOffset[xx], yo, _boxOffset[xx]+_boxLength[xx], yo+BOXH, 100, 100, 100, 100); //grey, faded
-            if (_gd._mode <= GM_REWORD) //only ARCADE and REWORD modes have empty boxes drawn
-                _boxes.blitTo( s, _boxOffset[xx], yo, xx+(_nWordBoxEmptyOffset-3));	//tile 0=3, 1=4, 2=5, 3=6 etc. letter words
-		}
+		//else the empty rect denoting no words of xx length at all is on the background
 	}	//for
 
 	//play controls always sit on top of anything else
@@ -532,7 +508,7 @@ void PlayGame::render_end(Screen* s)
 
 	//finished level so show success type and bonus etc
 	const int minGap = _gd._fntSmall.height();	//useful distance based on small font
-	const int yyTitle = _scorebar.height() + minGap;
+	const int yyTitle = _scorebar->height() + minGap;
 	const int yyReward = yyTitle +_gd._fntBig.height() + minGap;
 	const int yyBonus = (_yScratchBot+CURSORH+_boxOffsetY) + (2*_gd._fntBig.height());
 	switch (_success)
@@ -1082,8 +1058,10 @@ void PlayGame::handlePopup()
 		//user selected to save state (now at least a 6 letter word found)
 		//and allow resume game later, so follow on to POP_QUIT
 		_bSaveExit = true;
+		saveLevel(_countdown);		//as it is now, before the end of level fills in the rest
 	case PlayGamePopup::POP_QUIT:
 		//back to main menu - like L+R+Click (or ESC on PC)
+		if (!_bSaveExit) _gd.deleteQuickState();	//any save made on pause
 		_bAbort = true;
 		ppg::pushSDL_Event(USER_EV_END_COUNTDOWN); //try to exit more gracefully, pushes end of level
 		break;
@@ -1171,26 +1149,27 @@ bool PlayGame::touch_end(const Point &pt)
 		if (pt.x < _boxOffset[xx] || pt.x > _boxOffset[xx]+_boxLength[xx]) continue;
 
 		int nWords = _gd._words.wordsOfLength(xx);
-		if (nWords)	//column has words
+		if (nWords && pt.y >= yo)	//column has words
 		{
-			for (yy=0; yy<nWords; ++yy)	//down the screen
+			//boxes are evenly spaced down the screen, so work out the row
+			yy = (pt.y - yo) / (BOXH + BOXHGAP);
+			if (yy >= nWords) continue;
+
+			Point pBox(_boxOffset[xx], yo+(yy*(BOXH + BOXHGAP)));     //same as in render_play()
+			Rect r(pBox, pBox.add(Point(_boxLength[xx], BOXH)));
+			if (r.contains(pt))     //not in the gap below it
 			{
-				Point pBox(_boxOffset[xx], yo+(yy*(BOXH + BOXHGAP)));     //same as in render_play()
-				Rect r(pBox, pBox.add(Point(_boxLength[xx], BOXH)));
-				if (r.contains(pt))
+				if (!_doubleClick.done())
+					doDictionary();		//toggle dictionary mode
+				else
 				{
-					if (!_doubleClick.done())
-						doDictionary();		//toggle dictionary mode
-					else
-					{
-						_doubleClick.start(300);
-						_xxWordHi = xx;
-						_yyWordHi = yy;
-					}
-
-                    state_end_setup_scrollers();
-					return true;
+					_doubleClick.start(300);
+					_xxWordHi = xx;
+					_yyWordHi = yy;
 				}
+
+                state_end_setup_scrollers();
+				return true;
 			}
 		}
 	}
@@ -1319,10 +1298,10 @@ void PlayGame::slideRoundButtonsIn()
 
     //these four controls should always be created and available
     const int ms = 450;
-    _controlsPlay.getControlSprite(CTRLID_SHUFFLE)->startMoveTo(_posRButtonLeft, _posRButtonTop, ms);
-    _controlsPlay.getControlSprite(CTRLID_TRYWORD)->startMoveTo(_posRButtonLeft, _posRButtonBot, ms);
-    _controlsPlay.getControlSprite(CTRLID_TOTOP)->startMoveTo(_posRButtonRight, _posRButtonTop, ms);
-    _controlsPlay.getControlSprite(CTRLID_LAST)->startMoveTo(_posRButtonRight, _posRButtonBot, ms);
+    _controlsPlay.getControlSprite(CTRLID_SHUFFLE)->easeMoveTo(_posRButtonLeft, _posRButtonTop, ms, 0, Easing::EASE_OUTQUART);
+    _controlsPlay.getControlSprite(CTRLID_TRYWORD)->easeMoveTo(_posRButtonLeft, _posRButtonBot, ms, 0, Easing::EASE_OUTQUART);
+    _controlsPlay.getControlSprite(CTRLID_TOTOP)->easeMoveTo(_posRButtonRight, _posRButtonTop, ms, 0, Easing::EASE_OUTQUART);
+    _controlsPlay.getControlSprite(CTRLID_LAST)->easeMoveTo(_posRButtonRight, _posRButtonBot, ms, 0, Easing::EASE_OUTQUART);
 
     //enable menu and sound buttons
 //    _controlsPlay.enableControl(true, CTRLID_MENU);
@@ -1337,10 +1316,10 @@ void PlayGame::slideRoundButtonsOut()
     //these four controls should always be created and available
     const int ms = 450;
 	const int btnWidth = _controlsPlay.getControlSprite(CTRLID_SHUFFLE)->tileW();
-    _controlsPlay.getControlSprite(CTRLID_SHUFFLE)->startMoveTo(-btnWidth, _posRButtonTop, ms);
-    _controlsPlay.getControlSprite(CTRLID_TRYWORD)->startMoveTo(-btnWidth, _posRButtonBot, ms);
-    _controlsPlay.getControlSprite(CTRLID_TOTOP)->startMoveTo(SCREEN_WIDTH, _posRButtonTop, ms);
-    _controlsPlay.getControlSprite(CTRLID_LAST)->startMoveTo(SCREEN_WIDTH, _posRButtonBot, ms);
+    _controlsPlay.getControlSprite(CTRLID_SHUFFLE)->easeMoveTo(-btnWidth, _posRButtonTop, ms, 0, Easing::EASE_INOUTSINE);
+    _controlsPlay.getControlSprite(CTRLID_TRYWORD)->easeMoveTo(-btnWidth, _posRButtonBot, ms, 0, Easing::EASE_INOUTSINE);
+    _controlsPlay.getControlSprite(CTRLID_TOTOP)->easeMoveTo(SCREEN_WIDTH, _posRButtonTop, ms, 0, Easing::EASE_INOUTSINE);
+    _controlsPlay.getControlSprite(CTRLID_LAST)->easeMoveTo(SCREEN_WIDTH, _posRButtonBot, ms, 0, Easing::EASE_INOUTSINE);
 
     //disable menu and sound buttons
 //    _controlsPlay.enableControl(false, CTRLID_MENU);
@@ -1351,16 +1330,14 @@ void PlayGame::slideRoundButtonsOut()
 //process any events not handled by the main input function
 void PlayGame::handleEvent(SDL_Event &sdlevent)
 {
+	if (sdlevent.type == SDL_RENDER_TARGETS_RESET && _gamebg)
+	{
+		//the target texture's contents are lost (eg. a D3D device reset), so draw it again
+		prepareBackground();
+		return;
+	}
 	if (sdlevent.type == SDL_USEREVENT)
 	{
-		if (USER_EV_PING_COUNTDOWN == sdlevent.user.code)
-		{
-			if ( --_countdown < 11 || _pPopup)	//added pinger when in popup to warn user that timer still going...
-			{
-                Locator::audio().playSfx(AUDIO_SFX_PING);
-			}
-		}
-		else
 		if (USER_EV_END_MOVEMENT_ROUNDEL == sdlevent.user.code)
 		{
 		    //Event uses data1 as a simple int (as using a ptr to
@@ -1514,8 +1491,7 @@ void PlayGame::doMoveOn()
 		exit(ST_MENU);
 		break;
 	case SU_SAVEEXIT:
-        _gd.saveQuickState();       //save before back to menu
-        exit(ST_MENU);
+        exit(ST_MENU);              //already saved, when save was chosen
         break;
 
 	default:
@@ -1572,6 +1548,7 @@ void PlayGame::doPauseGame()
 
 		//release the countdown timer
 		startCountdown();
+		_gd.deleteQuickState();		//still playing, so nothing to resume
 		return;
 	}
 	//else is not paused, so check if we can pause
@@ -1588,6 +1565,10 @@ void PlayGame::doPauseGame()
 
 		statePush(PG_PAUSE);
 
+		//in case the game is closed while paused, resume as if unpaused
+		if (!_gd._options._bHeadless)
+			saveLevel((_countdown > 10) ? _countdown-10 : _countdown);
+
 		//prepare roundel class ready for a pause
 		tSharedImage &letters = Resource::image("roundel_letters.png");
 		_roundPaused = tAutoRoundels(new Roundels());
@@ -1599,13 +1580,27 @@ void PlayGame::doPauseGame()
 	}
 }
 
+//snapshot of the level being played, so a resume carries on from here
+void PlayGame::saveLevel(int countdown)
+{
+	tQuickStateSave level;
+	level._bLevel = true;
+	level._position = _gd._words.position();
+	level._target = _gd._words.getWordTarget();
+	level._letters = _round.getLetterOrder();
+	level._countdown = countdown;
+	level._countStart = _fastestCountStart;
+	_gd._words.getFound(level._found);
+	_gd.saveQuickState(level);
+}
+
 void PlayGame::newGame()
 {
 	//Y pos of scratch area, doesn't change during game so calc here first
 	//   (X pos depends on number of letters in word so calculated in newLevel()
 	//scratch letter area _yScratchTop (6 roundels on top)
 	//scratch box area _yScratchBot (6 boxes below roundels)
-	_yScratchTop = _scorebar.height() + GAME_GAP1;
+	_yScratchTop = _scorebar->height() + GAME_GAP1;
 	_yScratchBot = _yScratchTop + CURSORH + GAME_GAP1;
 
 	_gd._score.resetCurr();
@@ -1614,6 +1609,8 @@ void PlayGame::newGame()
 		_gd.loadQuickState();
 		_gd._state = ST_GAME;	//as if it was always...
 	}
+	else
+		_gd._words.setChallenge(_gd._challenge, _gd._diffLevel);	//or back to the shuffled list
 	_gd._unmatchedWords.clear();
 
 	if (_gd._mode == GM_TIMETRIAL)
@@ -1635,7 +1632,24 @@ void PlayGame::startCountdown()
 
 	Uint32 rate = 1000; //1 second
 	stopCountdown();	//make sure its stopped first
-	_countdownID = SDL_AddTimer(rate, countdown_callback, nullptr);
+	_countdownID = Locator::timers().add(rate, [this]() { return countdownTick(); });
+}
+
+//called by the timer wheel from the main loop each second
+Uint32 PlayGame::countdownTick()
+{
+	if (_countdown <= 0)
+	{
+		_countdownID = 0;
+		ppg::pushSDL_Event(USER_EV_END_COUNTDOWN);	//same as pushEndOfLevel(), handled this frame
+		return 0;
+	}
+
+	if ( --_countdown < 11 || _pPopup)	//added pinger when in popup to warn user that timer still going...
+	{
+        Locator::audio().playSfx(AUDIO_SFX_PING);
+	}
+	return 1000;
 }
 
 //stop the countdown timer redrawing the screen
@@ -1643,8 +1657,8 @@ void PlayGame::stopCountdown()
 {
 	if (_countdownID)
 	{
-		if (SDL_RemoveTimer(_countdownID)) _countdownID = 0;
-		clearEventBuffer();
+		Locator::timers().cancel(_countdownID);
+		_countdownID = 0;
 
 	  // Fade out all the audio channels in 1 second
 //	  Mix_FadeOutChannel(-1, 1000);
@@ -1658,14 +1672,6 @@ void PlayGame::stopCountdown()
 	}
 }
 
-//clear any unused events from the event queue
-//used to prevent timer going off after being closed etc
-void PlayGame::clearEventBuffer()
-{
-	SDL_Event sdlevent;
-	while (SDL_PollEvent(&sdlevent));	//empty event buffer
-}
-
 //define the number of seconds each difficulty level gets (in global.h)
 int PlayGame::maxCountdown()
 {
@@ -1684,6 +1690,7 @@ int PlayGame::maxCountdown()
 bool PlayGame::newLevel()
 {
 	stopCountdown();
+	_gd.savePersonalWords();	//from the level just finished
 
 	int xx;
 	for (xx=0; xx<=TARGET_MAX; ++xx)
@@ -1693,8 +1700,11 @@ bool PlayGame::newLevel()
 	}
 
 	std::string newword;
+	const tQuickStateSave &resume = _gd._resume;
+	if (resume._bLevel)
+		newword = resume._target;	//already set up by GameData::loadQuickState()
 	//nextWord() returns false if bad dictionary entry (XXXXXX corrupted or hacked) !
-	if (!_gd._words.nextWord(newword, _gd._diffLevel, _gd._mode))	//return next word found.
+	else if (!_gd._words.nextWord(newword, _gd._diffLevel, _gd._mode))	//return next word found.
 	{
         std::cerr << "Cannot load new level word" << std::endl;
 	    exit(ST_MENU);
@@ -1747,7 +1757,8 @@ bool PlayGame::newLevel()
 
 	_round.setWord(newword, Resource::image("roundel_letters.png"), _xScratch+2, _yScratchTop+2, 6, true);
 	_round.setBottomPos(_xScratch+2, _yScratchBot+2);
-	_round.jumbleWord(false);		//randomize the letters
+	if (!resume._bLevel || !_round.setLetterOrder(resume._letters))
+		_round.jumbleWord(false);		//randomize the letters
 	_round.easeMoveFrom(Screen::width(), 0, 800, 150, Easing::EASE_OUTQUART);//animate roundels into screen pos
 
 	//paint this levels word boxes onto the background for quick blit display rather
@@ -1766,8 +1777,28 @@ bool PlayGame::newLevel()
 	_yyWordHi = 0;			//highlight first 6 letter word in column
 	_maxwordlen = 0;		//always reset the fact that a 6 letter word not got yet
 
+	if (resume._bLevel)
+	{
+		//words already found, time left, as they were when saved
+		const tWordsInTarget wit = _gd._words.getWordsInTarget();
+		for (auto &it : wit)
+		{
+			if (!it.second) continue;
+			DictWord dictWord;
+			dictWord._word = it.first;
+			dictWord._found = true;
+			_wordsFound[it.first.length()].push_back(dictWord);
+			_maxwordlen = std::max(_maxwordlen, (int)it.first.length());
+		}
+		for (xx=0; xx<=TARGET_MAX; ++xx)
+			std::sort(_wordsFound[xx].begin(), _wordsFound[xx].end(), DictWord());
+		_countdown = resume._countdown;
+		_fastestCountStart = resume._countStart;
+		_gd._resume._bLevel = false;	//only the once
+	}
+
 	//prepare random 'success' title here ready for end of level
-	_randomTitle = g_randInt.random(4);		//0..3
+	_randomTitle = Locator::random().stream(RNG_SCREENS).below(4);		//0..3
 
 	//onscreen touch command icons
 	const int btnWidth = _controlsPlay.getControlSprite(CTRLID_SHUFFLE)->tileW();
@@ -1787,7 +1818,6 @@ bool PlayGame::newLevel()
     state_end_setup_scrollers();    //removes any scroll buttons used in end game state
 
 	startCountdown();
-	clearEventBuffer();	//start fresh each level
 	return true;
 }
 
@@ -1878,7 +1908,6 @@ void PlayGame::showSuccess(eSuccess newSuccess, int newBonus)
 	_bonusScore = newBonus;
 
 	//make sure player doesn't clear the screen before its seen
-	clearEventBuffer();
 	_waiting.start(500);	//half second before user can continue after level done
 }
 
@@ -2034,17 +2063,37 @@ void PlayGame::prepareBackground()
 {
 	//create the background to be used for this level,
 	//pre drawing so we dont need to do it each frame.
-	//...
+	//Drawn by the renderer straight into a target texture which is kept and
+	//reused for every level. Falls back to drawing it every frame if the
+	//renderer has no target support.
+	Screen &screen = Locator::screen();
+	layoutBackground();
+
+	if (!_gamebg && SDL_RenderTargetSupported(screen.renderer()))
+	{
+		_gamebg = tSharedImage(new Image());
+		if (_gamebg->createTarget(Screen::width(), Screen::height()))
+			SDL_SetTextureBlendMode(_gamebg->texture()->texture_sdl(), SDL_BLENDMODE_NONE);	//opaque, whole screen
+		else
+			_gamebg.reset();
+	}
 
-    Surface tmpSurface; //to build background before convert to texture (at end)
-	tmpSurface.create(Screen::width(), Screen::height());
-    ppg::drawSolidRect (&tmpSurface, 0, 0, Screen::width(), Screen::height(), GAMEBG_COLOUR);
+	if (_gamebg && screen.setTarget(_gamebg->texture()))
+	{
+		drawBackground(&screen);
+		screen.setTarget(nullptr);
+	}
+	else
+		_gamebg.reset();
+}
 
+//positions of the scorebar text and icons etc for this level
+void PlayGame::layoutBackground()
+{
 	//place score bar centered - in case screen bigger than graphic
-	int sb_x = (SCREEN_WIDTH - _scorebar.width())/2;  //in case sb w < screen w
-	int sb_w = _scorebar.width();
-	int sb_h = _scorebar.height();
-	ppg::blit_surface(_scorebar.surface(), nullptr, tmpSurface.surface(), sb_x, 0);
+	int sb_x = (SCREEN_WIDTH - _scorebar->width())/2;  //in case sb w < screen w
+	int sb_w = _scorebar->width();
+	int sb_h = _scorebar->height();
 
 	//prerender the score and words titles
 	//find out sizes and calc reasonable positions
@@ -2100,45 +2149,69 @@ void PlayGame::prepareBackground()
 
 	int equal_gap = (sb_w - middle_len - (edge_pad*2) - sound_w) / 3;    //space on bar len after edges removed, /3 for equal dist
 
-	int titles_y = ((sb_h - fontText.height()) / 2) + 2;	//+2 magic number - too high otherwise...?
-	int numbers_y = ((sb_h - fontNumbers.height()) / 2) + 2;	//+2 magic number - too high otherwise...?
+	int numbers_y = ((sb_h - fontScore.height()) / 2) + 2;	//+2 magic number - too high otherwise...?
 
-	int score_x = sound_right + equal_gap;          //x pos for "SCORE:"
-	_score0_x = score_x+score_len;                  //x pos for score "00000000"
+	_score_x = sound_right + equal_gap;             //x pos for "SCORE:"
+	_score0_x = _score_x+score_len;                 //x pos for score "00000000"
 	_score0_y = numbers_y;
 
-	int words_x = _score0_x+score0_len+equal_gap;   //x pos for "WORDS:"
-	_words0_x = words_x+words_len;                  //x pos for words "0000"
+	_words_x = _score0_x+score0_len+equal_gap;      //x pos for "WORDS:"
+	_words0_x = _words_x+words_len;                 //x pos for words "0000"
 	_words0_y = numbers_y;
 
 	_countdown0_x = (sb_x + sb_w) - (edge_pad / 2);
 	_countdown0_y = (sb_h - fontCounter.height()) / 2;
 
-	fontText.put_text(&tmpSurface, score_x, titles_y, "SCORE:", WHITE_COLOUR);
-	fontText.put_text(&tmpSurface, words_x, titles_y, "WORDS:", WHITE_COLOUR);
-
-	//draw mode and difficulty in bot right corner
-	//(before/under word boxes so if 8 6-letter words, it doesnt cover boxes up)
-	std::string strMode;
-	Surface modeSurface;
 	switch (_gd._mode)
 	{
-	case GM_ARCADE:		modeSurface.load("game_arcade.png");	_strMode = "ARCADE (" + _gd._diffName + ")";    break;
-	case GM_REWORD:		modeSurface.load("game_reword.png");	_strMode = "REWORD (" + _gd._diffName + ")";    break;
-	case GM_SPEEDER:	modeSurface.load("game_speeder.png");   _strMode = "SPEEDWORD (" + _gd._diffName + ")"; break;
-	case GM_TIMETRIAL:	modeSurface.load("game_timetrial.png"); _strMode = "TIMETRIAL (" + _gd._diffName + ")"; break;
+	case GM_ARCADE:		_modeImage = Resource::image("game_arcade.png");	_strMode = "ARCADE (" + _gd._diffName + ")";    break;
+	case GM_REWORD:		_modeImage = Resource::image("game_reword.png");	_strMode = "REWORD (" + _gd._diffName + ")";    break;
+	case GM_SPEEDER:	_modeImage = Resource::image("game_speeder.png");   _strMode = "SPEEDWORD (" + _gd._diffName + ")"; break;
+	case GM_TIMETRIAL:	_modeImage = Resource::image("game_timetrial.png"); _strMode = "TIMETRIAL (" + _gd._diffName + ")"; break;
 	default:break;
 	}
-	assert(modeSurface.surface());
-	modeSurface.setAlphaTransparency(100);
-	int mode_x = SCREEN_WIDTH - modeSurface.width() + 25; 	//slightly off screen
-	int mode_y = SCREEN_HEIGHT - modeSurface.height() + 25;	//ditto
-	ppg::blit_surface(modeSurface.surface(), nullptr, tmpSurface.surface(), mode_x, mode_y);
+	assert(_modeImage);
+}
+
+//everything that doesn't change during a level, including the empty word box
+//grid. Only highlighted boxes and the words themselves are drawn each frame
+void PlayGame::drawBackground(Screen *s)
+{
+	//opaque fill, as the target texture starts out undefined
+	SDL_BlendMode blend;
+	SDL_GetRenderDrawBlendMode(s->renderer(), &blend);
+	SDL_SetRenderDrawBlendMode(s->renderer(), SDL_BLENDMODE_NONE);
+	s->drawSolidRect(0, 0, Screen::width(), Screen::height(), GAMEBG_COLOUR);
+	SDL_SetRenderDrawBlendMode(s->renderer(), blend);	//as the rest of the frame expects
+
+	s->blit(_scorebar->texture(), nullptr, (SCREEN_WIDTH - _scorebar->width())/2, 0);
+
+	_gd._fntClean.put_text(s, _score_x, _score0_y, "SCORE:", BLACK_COLOUR);
+	_gd._fntClean.put_text(s, _words_x, _score0_y, "WORDS:", BLACK_COLOUR);
+
+	//draw mode and difficulty in bot right corner
+	//(before/under word boxes so if 8 6-letter words, it doesnt cover boxes up)
+	SDL_Texture *modeTex = _modeImage->texture()->texture_sdl();
+	SDL_SetTextureAlphaMod(modeTex, 100);
+	int mode_x = SCREEN_WIDTH - _modeImage->width() + 25; 	//slightly off screen
+	int mode_y = SCREEN_HEIGHT - _modeImage->height() + 25;	//ditto
+	s->blit(_modeImage->texture(), nullptr, mode_x, mode_y);
+	SDL_SetTextureAlphaMod(modeTex, 255);   //shared image, so put it back
 
 	//draw difficulty level in bot right corner
-	std::string strDiff = strMode + " (" + _gd._diffName + ")";
-	_gd._fntTiny.put_text_right(&tmpSurface, 4, SCREEN_HEIGHT - _gd._fntTiny.height() - 4, strDiff.c_str(), _gd._diffColour);
+	_gd._fntTiny.put_text_right(s, 4, SCREEN_HEIGHT - _gd._fntTiny.height() - 4, _strMode.c_str(), _gd._diffColour);
 
-    //now make texture to be rendered as background during actual play/update
-	_gamebg = tSharedImage(new Image(tmpSurface));
+	//the plain word boxes, as shown at the start of the level. The column
+	//offsets only scroll at the end of a level and never change the box count
+	const int yo = _yScratchBot + CURSORH + _boxOffsetY;	//start y offset
+	for (int xx=_shortestWordLen; xx<=_longestWordLen; ++xx)
+	{
+		const int nBoxes = std::min(_gd._words.wordsOfLength(xx), MAX_WORD_COL);
+		for (int yy = 0; yy < nBoxes; ++yy)
+			_boxes.blitTo(s, _boxOffset[xx], yo+(yy*(BOXH + BOXHGAP)), xx-3);	//tile 0=3, 1=4, 2=5, 3=6 etc. letter words
+
+		//draw empty rect to denote no words of xx length at all
+		if (nBoxes == 0 && _gd._mode <= GM_REWORD) //only ARCADE and REWORD modes have empty boxes drawn
+			_boxes.blitTo(s, _boxOffset[xx], yo, xx+(_nWordBoxEmptyOffset-3));
+	}
 }
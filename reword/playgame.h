@@ -11,6 +11,7 @@
 #include "roundels.h"
 #include "playgamepopup.h"
 #include "controls.h"
+#include "timerwheel.h"
 
 #include <string>
 #include <stack>
@@ -107,7 +108,7 @@ protected:
 	bool newLevel();
 	void startCountdown();
 	void stopCountdown();
-	void clearEventBuffer();
+	Uint32 countdownTick();
 	int maxCountdown();
 	void showSuccess(eSuccess newSuccess, int newBonus = 0);
 	void startPopup(Input *input);
@@ -120,8 +121,11 @@ protected:
 	void fillRemainingWords();
 	void doMoveOn();
 	void doPauseGame();
+	void saveLevel(int countdown);
 	void doDictionary();
 	void prepareBackground();
+	void layoutBackground();
+	void drawBackground(Screen *s);
     void calcArcadeNeededWords();
 
 	void render_play(Screen*);	//main play render fn
@@ -162,7 +166,8 @@ protected:
 private:
 	GameData &	_gd;			//shared data between screens (play classes)
 	tSharedImage _gamebg;
-	Surface     _scorebar;
+	tSharedImage _scorebar;
+	tSharedImage _modeImage;	//"ARCADE" etc faded in bot right of background
 	ImageAnim	_scratch;
 	ImageAnim	_boxes;
 	ImageAnim	_cursor;
@@ -218,7 +223,8 @@ private:
 	std::string _strMode;		//"ARCADE" etc to show in bot right screen
 
 	//timers
-	SDL_TimerID _countdownID;	//timer used to show timer countdown in game
+	TimerWheel::tTimerId _countdownID;	//timer used to show timer countdown in game
+	int			_countdown;		//seconds remaining
 	static Uint32 next_time;	//used for time_left() fn
 
 	//a list of found words so far (this level)
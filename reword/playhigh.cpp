@@ -417,7 +417,8 @@ void PlayHigh::insertNewScore()
     memset(_curr.inits, 0, sizeof(_curr.inits));
     memcpy(_curr.inits, _kbd.getBottomWord().c_str(), std::min(sizeof(_curr.inits), _kbd.getBottomWord().length()));
     _gd._score.insert(_mode, _diff, _pos, _curr);
-    _gd._score.save();	//save now so player can switch off or return to menu if wishes
+    if (!_gd._options._bHeadless)   //test runs leave the real table alone
+        _gd._score.save();	//save now so player can switch off or return to menu if wishes
     _gd._prev_inits = _curr.inits;
 }
 
@@ -658,15 +659,15 @@ void PlayHigh::prepareBackground()
 	//...
 
     Surface tmpSurface; //to build background before convert to texture (at end)
-    tmpSurface.load("menubg_plain.png");
+    Resource::image().loadSurface("menubg_plain.png", tmpSurface);
 
     Surface modeSurface;
 	switch (_mode)
 	{
-	case GM_ARCADE: modeSurface.load("menu_arcade.png"); break;
-	case GM_REWORD: modeSurface.load("menu_reword.png"); break;
-	case GM_SPEEDER: modeSurface.load("menu_speeder.png"); break;
-	case GM_TIMETRIAL: modeSurface.load("menu_timetrial.png"); break;
+	case GM_ARCADE: Resource::image().loadSurface("menu_arcade.png", modeSurface); break;
+	case GM_REWORD: Resource::image().loadSurface("menu_reword.png", modeSurface); break;
+	case GM_SPEEDER: Resource::image().loadSurface("menu_speeder.png", modeSurface); break;
+	case GM_TIMETRIAL: Resource::image().loadSurface("menu_timetrial.png", modeSurface); break;
 	default: break;
 	}
 	modeSurface.setAlphaTransparency(100);
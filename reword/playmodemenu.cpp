@@ -55,13 +55,14 @@ void PlayModeMenu::init(Input *input, Screen * scr)
 	addItem(MenuItem(1, PURPLE_COLOUR, "Classic", "Must get at least one all-letter word"));
 	addItem(MenuItem(2, GOLD_COLOUR, "SpeedWord", "Get the all-letter words quickly to continue"));
 	addItem(MenuItem(3, BLUE_COLOUR, "TimeTrial", "Get the most all-letter words in the time limit"));
+	addItem(MenuItem(98, ORANGE_COLOUR, "Daily", "Arcade with today's words, the same for everyone"));
 
 	addItem(MenuItem(255, RED_COLOUR, "Back", "Back to main menu"));
 
     if (bQSExists)
         setItem(99);    //start at resume item if there
     else
-       	setItem((int)_gd._mode);
+       	setItem(_gd._challenge ? 98 : (int)_gd._mode);
 
 	PlayMenu::init(input, scr);
 }
@@ -73,8 +74,14 @@ void PlayModeMenu::choose(MenuItem i)
 		_gd._state = ST_MENU;
 	else if (i.id() == 99)	    	// optional (ie. found file) resume available
 		_gd._state = ST_RESUME;
+	else if (i.id() == 98) {		// daily challenge, arcade with today's word order
+		_gd._mode = GM_ARCADE;
+		_gd._challenge = _gd.dailyChallengeKey();
+		_gd._state = ST_GAME;
+	}
 	else if (i.id() < 4) {			// 0..3, so play
 		_gd._mode = (eGameMode)i.id();
+		_gd._challenge = 0;
 		_gd._state = ST_GAME;
 	}
 
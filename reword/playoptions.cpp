@@ -62,13 +62,8 @@ PlayOptions::~PlayOptions()
 
     //save changed settings...
 
-    if (_gd._options.setDefaultWordFile(_wordFileList[_wordFileIdx]))
-    {
-        //load newly selected word file
-        _gd._words.load(RES_WORDS + _gd._options._defaultWordFile, SDL_GetTicks());
-        //load scores for this wordfile
-        _gd._score.loadUsingWordfileName(_gd._options._defaultWordFile);
-    }
+    //a new word file is loaded by GameData when it sees the change
+    _gd._options.setDefaultWordFile(_wordFileList[_wordFileIdx]);
 
     p = _controlsOptn.getControl(CTRLID_YES_NO);
     if (p) _gd._options.setSingleTap(p->isFirstState());  //first = yes
@@ -82,7 +77,7 @@ PlayOptions::~PlayOptions()
     p = _controlsOptn.getControl(CTRLID_MUSIC);
     if (p) _gd._options.setDefaultMusicOn(p->isFirstState());  //first = yes (on)
 
-    _gd._options.save();
+    //written in the background once they've settled
 }
 
 void PlayOptions::init(Input *input, Screen * scr)
@@ -3,13 +3,13 @@
 
 File:			random.cpp
 
-Class impl:		CRandom
+Class impl:		Rng, RandomStreams
 
-Description:	A random number generator class
-
-Author:			not sure?
-
-Date:			?
+Description:	Random number generators. Rng is xoshiro128** (Blackman and Vigna),
+				32 bit output from 128 bits of state, seeded through splitmix64 so
+				any seed, 0 included, gives a good start state. RandomStreams has
+				an Rng per subsystem, each seeded from the game seed and its
+				stream number, so they're independent and reproducible.
 
 Licence:		This program is free software; you can redistribute it and/or modify
 				it under the terms of the GNU General Public License as published by
@@ -29,75 +29,84 @@ Licence:		This program is free software; you can redistribute it and/or modify
 ////////////////////////////////////////////////////////////////////
 #include "random.h"
 
-#include <ctime>
-
+#include <atomic>
+#include <chrono>
 
-CRandom::CRandom(void)
+static std::uint64_t splitmix64(std::uint64_t &x)
 {
-   rseed = 1;
-   mti=CMATH_N+1;
+	std::uint64_t z = (x += 0x9e3779b97f4a7c15ull);
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+	return z ^ (z >> 31);
 }
 
-// Returns a number from 0 to n (excluding n)
-unsigned int CRandom::Random( unsigned int n )
+static inline std::uint32_t rotl(std::uint32_t x, int k)
 {
-    unsigned long y;
-    static unsigned long mag01[2]={0x0, CMATH_MATRIX_A};
-
-   if(n==0)
-     return(0);
-
-    /* mag01[x] = x * MATRIX_A for x=0,1 */
-
-    if (mti >= CMATH_N) { /* generate N words at one time */
-        int kk;
-
-        if (mti == CMATH_N+1)   /* if sgenrand() has not been called, */
-            SetRandomSeed(4357); /* a default initial seed is used   */
-
-        for (kk=0;kk<CMATH_N-CMATH_M;kk++) {
-            y = (mt[kk]&CMATH_UPPER_MASK)|(mt[kk+1]&CMATH_LOWER_MASK);
-            mt[kk] = mt[kk+CMATH_M] ^ (y >> 1) ^ mag01[y & 0x1];
-        }
-        for (;kk<CMATH_N-1;kk++) {
-            y = (mt[kk]&CMATH_UPPER_MASK)|(mt[kk+1]&CMATH_LOWER_MASK);
-            mt[kk] = mt[kk+(CMATH_M-CMATH_N)] ^ (y >> 1) ^ mag01[y & 0x1];
-        }
-        y = (mt[CMATH_N-1]&CMATH_UPPER_MASK)|(mt[0]&CMATH_LOWER_MASK);
-        mt[CMATH_N-1] = mt[CMATH_M-1] ^ (y >> 1) ^ mag01[y & 0x1];
-
-        mti = 0;
-    }
+	return (x << k) | (x >> (32 - k));
+}
 
-    y = mt[mti++];
-    y ^= CMATH_TEMPERING_SHIFT_U(y);
-    y ^= CMATH_TEMPERING_SHIFT_S(y) & CMATH_TEMPERING_MASK_B;
-    y ^= CMATH_TEMPERING_SHIFT_T(y) & CMATH_TEMPERING_MASK_C;
-    y ^= CMATH_TEMPERING_SHIFT_L(y);
+void Rng::setSeed(std::uint64_t seed)
+{
+	const std::uint64_t a = splitmix64(seed), b = splitmix64(seed);
+	_s[0] = (std::uint32_t)a;
+	_s[1] = (std::uint32_t)(a >> 32);
+	_s[2] = (std::uint32_t)b;
+	_s[3] = (std::uint32_t)(b >> 32);
+	if (!(_s[0] | _s[1] | _s[2] | _s[3])) _s[0] = 1;	//all zero never moves
+}
 
-    return (y%n);
+Rng::result_type Rng::operator()()
+{
+	const std::uint32_t result = rotl(_s[1] * 5, 7) * 9;
+	const std::uint32_t t = _s[1] << 9;
+	_s[2] ^= _s[0];
+	_s[3] ^= _s[1];
+	_s[1] ^= _s[2];
+	_s[0] ^= _s[3];
+	_s[2] ^= t;
+	_s[3] = rotl(_s[3], 11);
+	return result;
+}
 
+//Lemire's multiply and shift, redrawing the few values that would favour
+//the low numbers, rather than the % of rand() that favours them every time
+unsigned int Rng::below(unsigned int n)
+{
+	if (n == 0) return 0;
+	std::uint64_t m = (std::uint64_t)(*this)() * n;
+	if ((std::uint32_t)m < n)
+	{
+		const std::uint32_t threshold = (0u - n) % n;
+		while ((std::uint32_t)m < threshold)
+			m = (std::uint64_t)(*this)() * n;
+	}
+	return (unsigned int)(m >> 32);
 }
 
-void CRandom::SetRandomSeed(unsigned int n)
+Rng Rng::split()
 {
-   /* setting initial seeds to mt[N] using         */
-   /* the generator Line 25 of Table 1 in          */
-   /* [KNUTH 1981, The Art of Computer Programming */
-   /*    Vol. 2 (2nd Ed.), pp102]                  */
-   mt[0]= n & 0xffffffff;
-   for (mti=1; mti<CMATH_N; mti++)
-     mt[mti] = (69069 * mt[mti-1]) & 0xffffffff;
-
-   rseed = n;
+	const std::uint64_t seed = ((std::uint64_t)(*this)() << 32) | (*this)();
+	return Rng(seed);
 }
-unsigned int CRandom::GetRandomSeed(void)
+
+std::uint64_t Rng::entropy()
 {
-   return(rseed);
+	static std::atomic<std::uint64_t> count(0);	//so two calls in the same tick still differ
+	std::uint64_t x = (std::uint64_t)std::chrono::high_resolution_clock::now().time_since_epoch().count()
+		^ (std::uint64_t)(std::uintptr_t)&count;
+	x += ++count;
+	return splitmix64(x);
 }
 
-void CRandom::Randomize(void)
+
+RandomStreams::RandomStreams()
 {
-   SetRandomSeed((unsigned int)time(NULL));
+	setSeed((std::uint32_t)Rng::entropy());
 }
 
+void RandomStreams::setSeed(std::uint32_t seed)
+{
+	_seed = seed;
+	for (int s = 0; s < RNG_MAX; ++s)
+		_streams[s].setSeed(((std::uint64_t)s << 32) | seed);
+}
@@ -1,36 +1,56 @@
+//random.h
+//
+//The game's random numbers. Rng is a small fast generator (xoshiro128**) that
+//meets the std UniformRandomBitGenerator requirements, so it can be given to
+//std::shuffle and the std distributions. RandomStreams holds one for each
+//subsystem, all seeded from the one game seed, so the roundel jumbles, effects
+//etc. each repeat for the same seed whatever the others have drawn. The game's
+//is registered with the Locator.
+
 #if !defined __RANDOM_H__
 #define __RANDOM_H__
 
-/* Period parameters */
-#define CMATH_N 624
-#define CMATH_M 397
-#define CMATH_MATRIX_A 0x9908b0df /* constant vector a */
-#define CMATH_UPPER_MASK 0x80000000 /* most significant w-r bits */
-#define CMATH_LOWER_MASK 0x7fffffff /* least significant r bits */
-
-/* Tempering parameters */
-#define CMATH_TEMPERING_MASK_B 0x9d2c5680
-#define CMATH_TEMPERING_MASK_C 0xefc60000
-#define CMATH_TEMPERING_SHIFT_U(y) (y >> 11)
-#define CMATH_TEMPERING_SHIFT_S(y) (y << 7)
-#define CMATH_TEMPERING_SHIFT_T(y) (y << 15)
-#define CMATH_TEMPERING_SHIFT_L(y) (y >> 18)
-
-class CRandom {
-   // DATA
-   unsigned int     rseed;
-   unsigned long    mt[CMATH_N];       /* the array for the state vector */
-   int              mti;               /* mti==N+1 means mt[N] is not initialized */
-
-
-   // FUNCTIONS
+#include <cstdint>
+
+class Rng
+{
+public:
+	typedef std::uint32_t result_type;
+
+	explicit Rng(std::uint64_t seed = 0) { setSeed(seed); }
+	void			setSeed(std::uint64_t seed);	//any value, 0 included
+
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return 0xffffffffu; }
+	result_type		operator()();
+	unsigned int	below(unsigned int n);			//0..n-1 (0 if n is 0), unbiased
+
+	Rng				split();						//another generator, independent of this one
+
+	//a seed that differs each run, without std::random_device (which can block
+	//on some embedded kernels)
+	static std::uint64_t entropy();
+
+private:
+	std::uint32_t	_s[4];
+};
+
+enum eRngStream { RNG_ROUNDELS,	//letter jumbles
+				  RNG_EFFECTS,	//sprite delays etc.
+				  RNG_SCREENS,	//titles and anything else picked for show
+				  RNG_MAX };
+
+class RandomStreams
+{
 public:
-   CRandom(void);
+	RandomStreams();							//seeded from entropy()
+	void			setSeed(std::uint32_t seed);	//every stream, from the one seed
+	std::uint32_t	seed() const { return _seed; }
+	Rng &			stream(eRngStream s) { return _streams[s]; }
 
-   unsigned int Random(unsigned int n);
-   void         SetRandomSeed(unsigned int n);
-   unsigned int GetRandomSeed(void);
-   void         Randomize(void);
+private:
+	std::uint32_t	_seed;
+	Rng				_streams[RNG_MAX];
 };
 
 #endif // __RANDOM_H__
@@ -37,7 +37,8 @@ Licence:		This program is free software; you can redistribute it and/or modify
 #include "locator.h"    //##DEBUG##
 
 
-ResourceImg::ResourceImg() : _alpha(255), _alphaKey(ALPHA_COLOUR)
+ResourceImg::ResourceImg() : _tiles(1), _alpha(255), _alphaKey(ALPHA_COLOUR), _tileDir(Image::TILE_HORIZ),
+    _budget(0), _used(0), _useCount(0)
 {
     //ctor
 }
@@ -55,7 +56,11 @@ void ResourceImg::clear()
     //{
     //    delete it->second;
     //}
+    for (auto &it : _surfaces)
+        if (it.second.surface) SDL_FreeSurface(it.second.surface);
+    _surfaces.clear();
     _cache.clear();
+    _used = 0;
 }
 
 ////set the default alpha to be used if get needs to use it
@@ -81,6 +86,8 @@ bool ResourceImg::add(const std::string & imageFile,
     _alphaKey = cAlphaKey;
     _tileDir = tileDir;
 
+    SImageInfo info = { nTiles, cAlphaKey, iAlpha, tileDir };
+    _info[imageFile] = info;    //so it's reloaded the same way if evicted
     tSharedImage img = get(imageFile);
 
     _tiles = oldTiles;
@@ -103,20 +110,139 @@ bool ResourceImg::add(const std::string & imageFile,
 //into the map.
 tSharedImage &ResourceImg::get(const std::string & imageFile)
 {
-    tResourceMap::iterator it = _cache.find(imageFile);
-    if (it == _cache.end())
+    return entry(imageFile, false).image;
+}
+
+//copy of a cached image surface, for screens that draw onto it to build a
+//background, so the file is only decoded once not every time the screen shows
+bool ResourceImg::loadSurface(const std::string & imageFile, Surface &dest)
+{
+    SCacheEntry &e = entry(imageFile, true);
+    return e.surface && dest.clone(e.surface);
+}
+
+//find or (re)load an image or surface, collecting it from the loader
+//thread if it was preloaded
+ResourceImg::SCacheEntry & ResourceImg::entry(const std::string & imageFile, bool bSurface)
+{
+    tResourceMap &cache = bSurface ? _surfaces : _cache;
+    tResourceMap::iterator it = cache.find(imageFile);
+    if (it == cache.end())
     {
         //not found so try to load
-        tSharedImage image = tSharedImage(new Image(RES_IMAGES + imageFile, _alpha));
-        it = _cache.insert(it, std::make_pair(imageFile, image));
+        SCacheEntry e = { tSharedImage(), nullptr, 0, 0 };
+        if (bSurface)
+        {
+            Surface s;
+            if (s.load(imageFile))
+            {
+                e.surface = s.surface();
+                e.surface->refcount++;  //keep it once s goes
+                e.bytes = e.surface->pitch * e.surface->h;
+            }
+        }
+        else
+        {
+            std::map<std::string, SImageInfo>::const_iterator info = _info.find(imageFile);
+            const SImageInfo def = { _tiles, _alphaKey, _alpha, _tileDir };
+            const SImageInfo &i = (info == _info.end()) ? def : info->second;
+
+            e.image = tSharedImage(new Image(RES_IMAGES + imageFile, i.tiles, i.alphaKey, i.alpha));
+            if (e.image->initDone())
+            {
+                e.image->setTileCount(i.tiles, i.tileDir);
+                e.bytes = e.image->width() * e.image->height() * 4;   //near enough for a texture
+            }
+        }
+        _used += e.bytes;
+        it = cache.insert(it, std::make_pair(imageFile, e));
 
 #if _DEBUG
-std::cout << "# of images " << _cache.size() << " - added " << image->_dbgName << std::endl;
+std::cout << "# of images " << _cache.size() + _surfaces.size() << " - added " << imageFile
+    << (bSurface ? " (surface)" : "") << ", " << _used / 1024 << "KB in use" << std::endl;
 #endif
     }
+    it->second.lastUsed = ++_useCount;
     return it->second;
 }
 
+void ResourceImg::addToSet(int set, const std::string & imageFile, bool bSurface /*= false*/)
+{
+    SSetEntry e = { imageFile, bSurface };
+    _sets[set].push_back(e);
+}
+
+//called as a screen starts, once the previous one has released its sprites
+void ResourceImg::enterSet(int set)
+{
+    _resident.clear();
+    std::map<int, std::vector<SSetEntry> >::const_iterator it = _sets.find(set);
+    if (it != _sets.end())
+    {
+        for (auto &e : it->second)
+        {
+            _resident.insert(e.file);
+            entry(e.file, e.bSurface);
+        }
+    }
+    //the guessed next screens that weren't this one. Their decodes are
+    //outside the budget, so don't leave them sitting on the loader
+    Resource::loader().discardImages(_preloaded);
+    _preloaded.clear();
+    trim();
+}
+
+void ResourceImg::preloadSet(int set)
+{
+    std::map<int, std::vector<SSetEntry> >::const_iterator it = _sets.find(set);
+    if (it == _sets.end()) return;
+
+    for (auto &e : it->second)
+    {
+        const std::string fullName = RES_IMAGES + e.file;
+        if ((e.bSurface ? _surfaces : _cache).count(e.file) == 0 && !Resource::pack().has(fullName))
+        {
+            Resource::loader().queueImage(fullName);
+            _preloaded.insert(fullName);
+        }
+    }
+}
+
+//only if nothing but the cache holds it and the current screen doesn't need it
+bool ResourceImg::evictable(const std::string & imageFile, const SCacheEntry & e) const
+{
+    if (_resident.count(imageFile))
+        return false;
+    return !e.image || e.image.use_count() == 1;
+}
+
+//evict the least recently used images until back under budget
+void ResourceImg::trim()
+{
+    while (_budget && _used > _budget)
+    {
+        tResourceMap *lruCache = nullptr;
+        tResourceMap::iterator lru;
+        tResourceMap *caches[] = { &_cache, &_surfaces };
+        for (auto cache : caches)
+            for (tResourceMap::iterator it = cache->begin(); it != cache->end(); ++it)
+                if (evictable(it->first, it->second) && (!lruCache || it->second.lastUsed < lru->second.lastUsed))
+                {
+                    lruCache = cache;
+                    lru = it;
+                }
+        if (!lruCache)
+            break;  //everything left is in use
+
+#if _DEBUG
+std::cout << "Evicting image " << lru->first << " (" << lru->second.bytes / 1024 << "KB)" << std::endl;
+#endif
+        _used -= lru->second.bytes;
+        if (lru->second.surface) SDL_FreeSurface(lru->second.surface);
+        lruCache->erase(lru);
+    }
+}
+
 
 
 //////////////////////////////// Resource Locator/////////////////////////////
@@ -158,4 +284,36 @@ void Resource::registerImage(ResourceImg* img)
 
 }
 
+static AssetPack _nullpack;
+static AssetPack * _pack = &_nullpack;  //usable before registering (splash etc)
+
+AssetPack& Resource::pack()
+{
+    assert(_pack != nullptr);
+    return *_pack;
+}
+void Resource::registerPack(AssetPack* pack)
+{
+    if (pack == nullptr)
+        _pack = &_nullpack;   // revert to null service
+    else
+        _pack = pack;
+}
+
+static AsyncLoader _nullloader;
+static AsyncLoader * _loader = &_nullloader;
+
+AsyncLoader& Resource::loader()
+{
+    assert(_loader != nullptr);
+    return *_loader;
+}
+void Resource::registerLoader(AsyncLoader* loader)
+{
+    if (loader == nullptr)
+        _loader = &_nullloader;   // revert to null service
+    else
+        _loader = loader;
+}
+
 
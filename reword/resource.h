@@ -2,11 +2,37 @@
 #define RESOURCE_H
 
 #include "image.h"	//defines tSharedImage
+#include "assetpack.h"
+#include "loader.h"
 #include <map>
+#include <set>
+#include <vector>
 
+//Images are loaded on first use and kept while anything (a sprite etc) still
+//references them, or while they belong to the current screens residency set.
+//Anything else can be evicted, least recently used first, when over budget.
 class ResourceImg
 {
-    typedef std::map<std::string, tSharedImage> tResourceMap;
+    struct SImageInfo   //how to (re)load an image once evicted
+    {
+        Uint32          tiles;
+        SDL_Color       alphaKey;
+        Uint8           alpha;
+        Image::eTileDir tileDir;
+    };
+    struct SCacheEntry
+    {
+        tSharedImage    image;      //texture, shared with the sprites using it
+        SDL_Surface *   surface;    //or decoded pixels for screens that draw onto a copy
+        size_t          bytes;
+        Uint32          lastUsed;
+    };
+    struct SSetEntry
+    {
+        std::string     file;
+        bool            bSurface;
+    };
+    typedef std::map<std::string, SCacheEntry> tResourceMap;
 public:
 
     ResourceImg();
@@ -19,6 +45,19 @@ public:
                         SDL_Color cAlphaKey = ALPHA_COLOUR, Uint8 iAlpha = 255,
                         Image::eTileDir tileDir = Image::TILE_HORIZ);
     tSharedImage &get(const std::string & imageFile);
+    bool loadSurface(const std::string & imageFile, Surface &dest);  //copy of the cached pixels
+
+    //per screen residency
+    void addToSet(int set, const std::string & imageFile, bool bSurface = false);
+    void enterSet(int set);     //load everything the screen needs then trim to budget
+    void preloadSet(int set);   //decode a likely next screens images in the background
+    void setBudget(size_t bytes) { _budget = bytes; }   //0 = no limit
+    size_t used() const { return _used; }
+
+protected:
+    SCacheEntry & entry(const std::string & imageFile, bool bSurface);
+    bool evictable(const std::string & imageFile, const SCacheEntry & e) const;
+    void trim();
 
 protected:
     Uint32          _tiles;
@@ -27,6 +66,14 @@ protected:
     Image::eTileDir _tileDir;
 
     tResourceMap    _cache;
+    tResourceMap    _surfaces;
+    std::map<std::string, SImageInfo> _info;
+    std::map<int, std::vector<SSetEntry> > _sets;
+    std::set<std::string> _resident;    //current screens images, not evicted
+    std::set<std::string> _preloaded;   //queued on the loader for a screen that may not come next
+    size_t          _budget;
+    size_t          _used;
+    Uint32          _useCount;          //lru clock
 };
 
 
@@ -38,6 +85,12 @@ public:
     static ResourceImg&     image();
     static tSharedImage&    image(const std::string &imgFile);
     static void             registerImage(ResourceImg* res);
+
+    static AssetPack&       pack();     //baked images/fonts, empty if none registered
+    static void             registerPack(AssetPack* pack);
+
+    static AsyncLoader&     loader();   //startup background loading, loads inline if none registered
+    static void             registerLoader(AsyncLoader* loader);
 };
 
 #endif // RESOURCE_H
@@ -98,6 +98,7 @@ Licence:		This program is free software; you can redistribute it and/or modify
 
 #include <string>
 #include <iostream>
+#include <cstdlib>
 
 int main(int argc, char* argv[]) // <- this must match exactly, since SDL rewrites it
 {
@@ -129,12 +130,90 @@ int main(int argc, char* argv[]) // <- this must match exactly, since SDL rewrit
 			options._bMute = true;
 			continue;
 		}
+		if ("-bake" == arg)
+		{
+		    //decode all images and fonts once and write them to the asset pack
+			options._bBake = true;
+			continue;
+		}
+		if ("-imgmem" == arg && i+1 < argc)
+		{
+		    //image cache size in MB, least recently used evicted beyond this
+			options.set(OPT_IMAGEMB, argv[++i], false);
+			continue;
+		}
+		if ("-audiobuf" == arg && i+1 < argc)
+		{
+		    //mixer buffer size in samples, smaller is less lag but may crackle
+			options.set(OPT_AUDIOBUF, argv[++i], false);
+			continue;
+		}
+		if ("-headless" == arg)
+		{
+		    //no window or sound, play from a script as fast as possible and report timings
+			options._bHeadless = true;
+			options._bSound = false;
+			continue;
+		}
+		if ("-script" == arg && i+1 < argc)
+		{
+			options._simScript = argv[++i];
+			continue;
+		}
+		if ("-levels" == arg && i+1 < argc)
+		{
+			options.set(OPT_LEVELS, argv[++i], false);
+			continue;
+		}
+		if ("-bot" == arg)
+		{
+		    //headless, with a bot finding words instead of following a script
+			options._bBot = true;
+			options._bHeadless = true;
+			options._bSound = false;
+			continue;
+		}
+		if ("-skill" == arg && i+1 < argc)
+		{
+			options.set(OPT_SKILL, argv[++i], false);
+			continue;
+		}
+		if ("-think" == arg && i+1 < argc)
+		{
+			options.set(OPT_THINK, argv[++i], false);
+			continue;
+		}
+		if ("-benchease" == arg)
+		{
+		    //time the easing maths and exit
+			benchEasing();
+			return 0;
+		}
+		if ("-record" == arg && i+1 < argc)
+		{
+		    //log input and word seeds so the session can be replayed
+			options._recordFile = argv[++i];
+			continue;
+		}
+		if ("-replay" == arg && i+1 < argc)
+		{
+		    //play a recorded session back headless, to time or profile it
+			options._replayFile = argv[++i];
+			options._bHeadless = true;
+			options._bSound = false;
+			continue;
+		}
 		if ("-nosound" == arg)
 		{
 		    //not same as mute, which just starts the game muted. This disables sound.
 			options._bSound = false;
 			continue;
 		}
+		if (options.setArg(arg))
+		{
+		    //--key=value for any option, for this run only
+			continue;
+		}
 		//else ignore anything else for now
 	}
 
@@ -147,7 +226,22 @@ int main(int argc, char* argv[]) // <- this must match exactly, since SDL rewrit
 				<< "  Params:  " << std::endl
 				<< "  -nosound   -  disable all sound (sfx and music)" << std::endl
 				<< "  -mute      -  start with muted fx and music" << std::endl
-				<< std::endl;
+				<< "  -bake      -  write images/fonts to " << RES_ASSETPACK << " and exit" << std::endl
+				<< "  -imgmem N  -  limit cached images to N MB (0 = no limit, default " << IMAGE_BUDGET_MB << ")" << std::endl
+				<< "  -audiobuf N - mix sound in buffers of N samples (default " << SOUND_CHUNK << ")" << std::endl
+				<< "  -headless  -  no display or sound, play scripted input flat out and report frame timings" << std::endl
+				<< "  -script F  -  headless input script file (default plays SpeedWord)" << std::endl
+				<< "  -levels N  -  headless run stops after N levels (default 20)" << std::endl
+				<< "  -bot       -  headless, played by a bot that finds some of each level's words" << std::endl
+				<< "  -skill N   -  bot finds N% of the words (default 80)" << std::endl
+				<< "  -think N   -  bot takes about N ms to find each word (default 800)" << std::endl
+				<< "  -record F  -  record input to trace file F" << std::endl
+				<< "  -replay F  -  replay trace file F headless and report frame timings" << std::endl
+				<< "  -benchease -  time easing 1k and 10k tweens, one at a time and by the Easing store, and exit" << std::endl
+				<< std::endl
+				<< "  Options (saved ones are in options.dat, these change them for this run only):" << std::endl;
+		GameOptions::help(std::cout);
+		std::cout << std::endl;
 
         return 0;
     }
@@ -156,16 +250,16 @@ int main(int argc, char* argv[]) // <- this must match exactly, since SDL rewrit
 	Game game;
 	if (game.init(options))
 	{
+	    if (options._bBake)
+            return 0;   //pack written, nothing else to do
 		if (game.run())
 		{
             std::cerr << "Exit ok" << std::endl;
-		    exit(0);
-		    return 0;
+		    return 0;   //not exit(), so game and options are destroyed and flushed
 		}
 		//else fall through to return error
 	}
 	std::cerr << "Error : " << game.lastError() << std::endl;
-    exit(1);
     return 1;
 }
 
@@ -51,26 +51,50 @@ Licence:		This program is free software; you can redistribute it and/or modify
 #include <iostream>
 
 
-//single Roundel copy
-Roundel& Roundel::operator=(const Roundel &r)
-{
-    // Check for self-assignment
-    if (this != &r)      // not same object
-    {
-        this->_letter = r._letter;
-        this->_pos = r._pos;
-        this->_spr = new Sprite(*r._spr);
-    }
-    return *this;
-}
-
-//now Roundels
-
 Roundels::Roundels() :
     _xScratchTop(0), _yScratchTop(28), //legacy GP2X y positions
     _xScratchBot(0), _yScratchBot(73),
     _bCopyBot(false)
 {
+    reservePool(TARGET_MAX);
+}
+
+//make sure the pool has a letter and a bottom copy for nLetters.
+//Only grows, and only when no roundels are in use (pointers into it)
+void Roundels::reservePool(unsigned int nLetters)
+{
+    if (_sprPool.size() >= nLetters * 2) return;
+
+    _sprPool.clear();
+    _sprPool.resize(nLetters * 2);
+    _rndPool.resize(nLetters * 2);
+    _rndFree.reserve(nLetters);
+    _top.reserve(nLetters);
+    _bot.reserve(nLetters);
+    _last.reserve(nLetters);
+    for (unsigned int i = 0; i < _sprPool.size(); ++i)
+    {
+        //connect each sprite roundel to the event function slot, once
+        _sprPool[i]._sigEvent2.Connect(this, &Roundels::slotEvent);
+        _rndPool[i]._spr = &_sprPool[i];
+    }
+}
+
+//take a free bottom copy roundel and copy r into it
+Roundel *Roundels::copyRoundel(const Roundel *r)
+{
+    if (_rndFree.empty()) return nullptr;
+    Roundel *copy = _rndFree.back();
+    _rndFree.pop_back();
+    copy->_letter = r->_letter;
+    copy->_pos = r->_pos;
+    *copy->_spr = *r->_spr;     //keeps its own event connection
+    return copy;
+}
+
+void Roundels::freeRoundel(Roundel *r)
+{
+    _rndFree.push_back(r);
 }
 
 Roundels::~Roundels()
@@ -210,13 +234,10 @@ bool Roundels::tap(const Point &pt)
 
 void Roundels::cleanUp()
 {
-	tRoundVect::iterator it;
-	for (it = _top.begin(); it != _top.end(); ++it) if (*it) delete *it;
+	//all pooled, so just forget them
 	_top.clear();
-
-    //bottom may be empty or have _bCopyBot entries, so always delete
-    for (it = _bot.begin(); it != _bot.end(); ++it) if (*it) delete *it;
 	_bot.clear();
+	_rndFree.clear();
 
 	_botLength = _botLengthMax = 0;
 
@@ -261,14 +282,18 @@ void Roundels::setWord(const std::string &wrd,
 	_bHoriz = bHoriz;
 	_botLengthMax = _word.length();
 
+	//first wrd.length() of the pool are the letters, the rest bottom copies
+	reservePool(wrd.length());
+	_sprFresh.setImage(letters);
+	for (int i = (int)_rndPool.size() - 1; i >= (int)wrd.length(); --i)
+		_rndFree.push_back(&_rndPool[i]);
+
 	for(int i = 0; i < (int)wrd.length(); ++i)
 	{
-		//for each letter in string, add its roundel
-		Roundel *prnd = new Roundel();
-		Sprite *pspr = new Sprite(letters);
-
-        //connect each sprite roundel to the event function slot
-        pspr->_sigEvent2.Connect(this, &Roundels::slotEvent);
+		//for each letter in string, reuse its roundel
+		Roundel *prnd = &_rndPool[i];
+		Sprite *pspr = prnd->_spr;
+		*pspr = _sprFresh;
 
 		pspr->setFrame(wrd[i]-65);
 
@@ -278,7 +303,6 @@ void Roundels::setWord(const std::string &wrd,
 
 		prnd->_letter = wrd[i];	//wrd[i] - 65 == 0=A, 1=B
 		prnd->_pos = i;			//letter position in string
-		prnd->_spr = pspr;		//pointer to sprite
 
 		//set up basic positions of each letter in the string
 		recalcXYPosition(prnd);
@@ -494,8 +518,7 @@ bool Roundels::jumbleWord(bool bAnimate /*=true*/)
 
 			do
 			{	//rand another letter position
-				xx2 = (rand()%_top.size());	//0..5
-				//xx2 = ((int)_gd._myrand.Random(6));	//0..5
+				xx2 = Locator::random().stream(RNG_ROUNDELS).below(_top.size());	//0..5
 			} while (xx2 == xx || !(_top[xx2]));
 
 			//swap the actual pointers to the roundels
@@ -618,7 +641,7 @@ bool Roundels::moveLetterUp(bool bEffect /*=true*/)
         }
 
         //need to remove from bottom, but leave top alone
-        delete _bot[_cx];
+        freeRoundel(_bot[_cx]);
         _bot[_cx] = 0;
         _botLength--;
 
@@ -695,7 +718,7 @@ bool Roundels::moveLetterDown(bool bEffect /*=true*/)
 	    }
 	    _bot[_botLengthMax-1] = 0;
 	    _botLength--;
-	    delete orig;
+	    freeRoundel(orig);
 	}
 
     if (_botLength >= _botLengthMax) return false;    //can't move any more
@@ -719,9 +742,8 @@ bool Roundels::moveLetterDown(bool bEffect /*=true*/)
             if (_bCopyBot)
             {
                 //duplicate (copy) sprite
-                Roundel *r = new Roundel();
-                *r = *(_top[_cx]);
-                _bot[xx] = r;
+                _bot[xx] = copyRoundel(_top[_cx]);
+                if (!_bot[xx]) return false;
             }
             else
             {
@@ -865,6 +887,53 @@ int Roundels::cursorAt(Point pt)
 
 //move the letters currently on the bottom row back
 //to the top, to the gaps already there
+std::string Roundels::getLetterOrder()
+{
+	std::string order;
+	int nBot = 0;
+	for (int xx=0; xx < (int)_word.length() && xx < (int)_top.size(); ++xx)
+	{
+		if (_top[xx])
+			order += _top[xx]->_letter;
+		else
+		{
+			//gap, filled with the next bottom letter as clearAllToTop() does
+			while (nBot < (int)_bot.size() && !_bot[nBot]) ++nBot;
+			if (nBot < (int)_bot.size()) order += _bot[nBot++]->_letter;
+		}
+	}
+	return order;
+}
+
+//reorder the top row letters, after setWord() and before any are moved
+bool Roundels::setLetterOrder(const std::string &order)
+{
+	if (order.length() != _top.size()) return false;
+	std::string a(order), b(_word);
+	std::sort(a.begin(), a.end());
+	std::sort(b.begin(), b.end());
+	if (a != b) return false;	//not this word's letters
+	if (std::count(_top.begin(), _top.end(), (Roundel*)nullptr)) return false;	//not all on top
+
+	for (int xx=0; xx < (int)_top.size(); ++xx)
+	{
+		for (int xx2=xx; xx2 < (int)_top.size(); ++xx2)
+		{
+			if (_top[xx2] && _top[xx2]->_letter == order[xx])
+			{
+				std::swap(_top[xx], _top[xx2]);
+				break;
+			}
+		}
+	}
+	for (int xx=0; xx < (int)_top.size(); ++xx)
+	{
+		_top[xx]->_pos = xx;
+		recalcXYPosition(_top[xx]);
+	}
+	return true;
+}
+
 void Roundels::clearAllToTop(bool bResetCursor /*=true*/)
 {
 //	if (isMoving()) return;	//can't move if any already moving
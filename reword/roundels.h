@@ -12,13 +12,11 @@
 #include "states.h"
 #include "i_play.h"
 
+//a letter, its sprite is one of the Roundels pool (so not owned)
 class Roundel
 {
 public:
     Roundel() : _letter(0), _pos(0), _spr(0) {}
-    ~Roundel() { delete _spr; }
-
-    Roundel& operator=(const Roundel &r);
 
     char		_letter;
     int			_pos;
@@ -66,6 +64,11 @@ public:
 	std::string getBottomWord();
 	int getBottomWordLength() { return _botLength; }
 
+	//letters as they'd be with the bottom row cleared back to the top, and
+	//putting them back in that order (for resuming a saved level)
+	std::string getLetterOrder();
+	bool setLetterOrder(const std::string &order);
+
 	void clearAllToTop(bool bResetCursor = true);
 	void setWordToLast(const std::string &strOverride = "");
 
@@ -98,6 +101,9 @@ public:
 protected:
 
     bool selectKbdLetter(char letter);
+    void reservePool(unsigned int nLetters);
+    Roundel *copyRoundel(const Roundel *r);
+    void freeRoundel(Roundel *r);
 	void recalcXYPosition(Roundel *r);
 	int calcXPos(Roundel *r);
 	int calcYPos(Roundel *r);
@@ -110,6 +116,14 @@ protected:
 	tRoundVect	_bot;
 	tRoundVect	_last;			//letters of last word tried (only uses copies of pointers)
 
+	//every roundel and sprite in use points into these, so setWord() and
+	//letter moves never allocate. Sized for a letter and a bottom copy of
+	//it for each of TARGET_MAX letters, or a longer word if given one.
+	std::vector<Sprite>		_sprPool;
+	std::vector<Roundel>	_rndPool;	//[i]._spr is &_sprPool[i]
+	tRoundVect	_rndFree;		//bottom copies not in use (copy mode)
+	Sprite		_sprFresh;		//new sprite state, copied over a pooled one to reuse it
+
 	std::string	_word;			//original word used to set roundels
 
     std::string _pressResource;
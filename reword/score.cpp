@@ -15,6 +15,7 @@ History:		Version	Date		Change
 				-------	----------	--------------------------------
 				0.4		03.03.2008	New format score file incl. speeder & TimeTrial
 				0.6     01.12.2011  Add Arcade mode scoring
+				0.7     19.10.2026  Portable checksummed format, entries appended
 
 Licence:		This program is free software; you can redistribute it and/or modify
 				it under the terms of the GNU General Public License as published by
@@ -40,7 +41,10 @@ Licence:		This program is free software; you can redistribute it and/or modify
 
 #include <iostream>
 #include <cerrno>
+#include <cstring>
 #include <filesystem>
+#include <iterator>
+#include <stdexcept>
 
 
 Score::Score()
@@ -53,6 +57,8 @@ Score::Score()
 	_scorefile = RES_BASE + "hiscore.dat";
 #endif
 	_seed = 0;
+	_bCanAppend = false;
+	_journal = 0;
 }
 
 void Score::init()
@@ -99,6 +105,88 @@ Uint32 Score::loadUsingWordfileName(const std::string &wordfile)
     return load(scorefile);
 }
 
+//score file layout from v3, written field by field little endian so the same
+//file works on any platform:
+//	0x00 0x03, table count, 12 tables (4 modes x 3 diffs) of 10 entries, crc32
+//then any entries added since, each appended as its own record with a crc32:
+//	'A', mode, diff, position, entry, crc32
+//A crash part way through an append only loses that entry, as loading stops at
+//the first record that doesn't check out, and the whole file is only ever
+//replaced by renaming a complete new one over it.
+static const int SCORE_FORMAT = 0x03;		//0x01 v0.4, 0x02 v0.6 arcade, 0x03 portable
+static const int SCORE_TABLES = 12;
+static const int SCORE_ENTRIES = 10;		//saved per table, [10] is only for inserting
+static const size_t SCORE_ENTRY_BYTES = 20;	//inits + words, score, fastest, ttSeconds
+static const size_t SCORE_RECORD_BYTES = 4 + SCORE_ENTRY_BYTES + 4;
+static const unsigned char SCORE_APPEND = 'A';
+static const size_t SCORE_JOURNAL_MAX = 32;	//appended records before the file is rewritten
+
+static Uint32 crc32(const unsigned char *p, size_t len, Uint32 crc = 0)
+{
+	static Uint32 table[256] = { 0 };
+	if (!table[1])
+	{
+		for (Uint32 n = 0; n < 256; ++n)
+		{
+			Uint32 c = n;
+			for (int k = 0; k < 8; ++k)
+				c = (c & 1) ? 0xEDB88320 ^ (c >> 1) : c >> 1;
+			table[n] = c;
+		}
+	}
+	crc = ~crc;
+	while (len--)
+		crc = table[(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+	return ~crc;
+}
+
+static void putU32(std::vector<unsigned char> &out, Uint32 v)
+{
+	out.push_back(v & 0xFF);
+	out.push_back((v >> 8) & 0xFF);
+	out.push_back((v >> 16) & 0xFF);
+	out.push_back((v >> 24) & 0xFF);
+}
+
+static Uint32 getU32(const unsigned char *p)
+{
+	return p[0] | (p[1] << 8) | (p[2] << 16) | ((Uint32)p[3] << 24);
+}
+
+static void putEntry(std::vector<unsigned char> &out, const HiScoreEntry &e)
+{
+	out.insert(out.end(), e.inits, e.inits + 4);
+	putU32(out, e.words);
+	putU32(out, e.score);
+	putU32(out, e.fastest);
+	putU32(out, e.ttSeconds);
+}
+
+//from v0.4 files too, as the handhelds and PCs were all little endian
+static void getEntry(const unsigned char *p, HiScoreEntry &e)
+{
+	memcpy(e.inits, p, 4);
+	e.inits[3] = '\0';
+	e.words = getU32(p + 4);
+	e.score = getU32(p + 8);
+	e.fastest = getU32(p + 12);
+	e.ttSeconds = getU32(p + 16);
+}
+
+//tables in file order
+HiScoreLevels *Score::table(int t)
+{
+	HiScoreLevels *modes[] = { _hiScore, _hiScoreS6, _hiScoreTT, _hiScoreRA };
+	return &modes[t / 3][t % 3];
+}
+
+void Score::writeTables(std::vector<unsigned char> &out)
+{
+	for (int t = 0; t < SCORE_TABLES; ++t)
+		for (int item = 0; item < SCORE_ENTRIES; ++item)
+			putEntry(out, table(t)->level[item]);
+}
+
 //return a hash total to help seed random number gen
 //NOTE: from v0.4, save files lead with a zero byte and a version byte to allow future score
 // 		file mods without the player having to trash the score file and restart from scratch
@@ -111,120 +199,146 @@ Uint32 Score::load(const std::string &scorefile)
 	std::cout << "Loading score file: " << _scorefile << std::endl;
 
 	init();
+	_pending.clear();
+	_bCanAppend = false;
+	_journal = 0;
 
-	//We add up byte values making up the score table to create the value used in
-	//seeding the random number generator. Do it this way to get a slightly
-	//different value each time the high score changes (as thats about the only
-	//consistently changing persisted value we can use). I believe there isnt a
-	//variable enough time clock on the gp2x to use for this purpose.
-
-	unsigned int total = 0, diff = 0, item = 0;
-	std::ifstream in(_scorefile.c_str());
-
+	//small, so read it in one go
+	std::ifstream in(_scorefile.c_str(), std::ios::in | std::ios::binary);
+	std::vector<unsigned char> buf;
 	if (in.is_open())
+		buf.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+
+	if (buf.size() >= 2 && 0 == buf[0] && SCORE_FORMAT == buf[1])
+		loadPortable(buf);
+	else if (buf.size() >= 2 && 0 == buf[0] && (0x01 == buf[1] || 0x02 == buf[1]))
 	{
-		char version = 0, format = 0;
-		version = in.get();
-		if (in.bad()) return 0; 	//can't read first char - poss empty file
-		if (0 == version)
-		{
-			//First byte is a zero (so is a v0.4 type score file) not an initial.
-			//Score file versioning started in v0.4. Before that it was just a
-			//straight dump of all 3 _hiScore entries (see old code in else block)
-			format = in.get();
-			if (in.bad()) return 0; 	//can't read version char - poss corrupt file
-			if (format >= 0x01)		//first generation format
-			{
-				//load a version 0.4 save file
-				for (diff=0; diff<3; ++diff)	//3 levels easy, med, hard
-					in.read(reinterpret_cast<char*>(&_hiScore[diff]), sizeof(_hiScore[0]));
-				//from v0.4, speeder and TimeTrial included in scores
-				for (diff=0; diff<3; ++diff)
-					in.read(reinterpret_cast<char*>(&_hiScoreS6[diff]), sizeof(_hiScoreS6[0]));
-				for (diff=0; diff<3; ++diff)
-					in.read(reinterpret_cast<char*>(&_hiScoreTT[diff]), sizeof(_hiScoreTT[0]));
-			}
-			if (format >= 0x02)		//2nd generation format
-			{
-				//load arade scores
-				for (diff=0; diff<3; ++diff)	//3 levels easy, med, hard
-					in.read(reinterpret_cast<char*>(&_hiScoreRA[diff]), sizeof(_hiScoreRA[0]));
-			}
-			//else - no other versions needed yet
-		}
-		else
-		{
-			//is an old style (pre v0.4) score file so load it in as before.
-			//On saving, it will be output as the latest format, along with a version byte
-			in.seekg (0, std::ios::beg);	//back to start
-			HiScoreLevelsPre04 hiScorePre04;
-			for (diff=0; diff<3; ++diff)	//3 levels easy, med, hard
+		//v0.4 and v0.6 dumped the packed structs, all 11 entries of each table
+		const size_t tableBytes = 11 * SCORE_ENTRY_BYTES;
+		const int tables = (0x02 == buf[1]) ? 12 : 9;	//arcade from v0.6
+		for (int t = 0; t < tables && 2 + (t + 1) * tableBytes <= buf.size(); ++t)
+			for (int item = 0; item < SCORE_ENTRIES; ++item)
+				getEntry(&buf[2 + t * tableBytes + item * SCORE_ENTRY_BYTES], table(t)->level[item]);
+	}
+	else if (!buf.empty() && 0 != buf[0])
+	{
+		//is an old style (pre v0.4) score file, 3 tables of 11 (inits, words, score).
+		//On saving, it will be output as the latest format
+		const size_t entryBytes = 12, tableBytes = 11 * entryBytes;
+		for (int diff = 0; diff < 3 && (diff + 1) * tableBytes <= buf.size(); ++diff)
+			for (int item = 0; item < SCORE_ENTRIES; ++item)
 			{
-				memset(&hiScorePre04, 0, sizeof(hiScorePre04));
-				in.read(reinterpret_cast<char*>(&hiScorePre04), sizeof(hiScorePre04));
-				//copy old format to new format
-				for (item=0; item<10; ++item)
-				{
-					memcpy(_hiScore[diff].level[item].inits, hiScorePre04.level[item].inits, 4);
-					_hiScore[diff].level[item].words = hiScorePre04.level[item].words;
-					_hiScore[diff].level[item].score = hiScorePre04.level[item].score;
-					_hiScore[diff].level[item].fastest = 0;
-				}
+				const unsigned char *p = &buf[diff * tableBytes + item * entryBytes];
+				HiScoreEntry &e = _hiScore[diff].level[item];
+				memcpy(e.inits, p, 4);
+				e.inits[3] = '\0';
+				e.words = getU32(p + 4);
+				e.score = getU32(p + 8);
 			}
-		}
-		//add up loaded bytes
-		int tpos = 0;
-		unsigned char *p;
-		for (tpos=0, p=(unsigned char*)&_hiScore[0]; tpos < (int)sizeof(_hiScore[0])*3; ++tpos) { total += (unsigned int)*p; ++p; }
-		for (tpos=0, p=(unsigned char*)&_hiScoreS6[0]; tpos < (int)sizeof(_hiScoreS6[0])*3; ++tpos) { total += (unsigned int)*p; ++p; }
-		for (tpos=0, p=(unsigned char*)&_hiScoreTT[0]; tpos < (int)sizeof(_hiScoreTT[0])*3; ++tpos) { total += (unsigned int)*p; ++p; }
-		for (tpos=0, p=(unsigned char*)&_hiScoreRA[0]; tpos < (int)sizeof(_hiScoreRA[0])*3; ++tpos) { total += (unsigned int)*p; ++p; }
 	}
-	_seed = total;
-	return total;
+	else if (!buf.empty())
+		std::cerr << "Unknown score file format " << (int)buf[1] << ", not loaded" << std::endl;
+
+	//The random number seed used to add up the bytes of the score tables, to
+	//get a slightly different value each time the high scores change (as
+	//thats about the only consistently changing persisted value we can use).
+	//A crc of them does the same job.
+	std::vector<unsigned char> tables;
+	writeTables(tables);
+	_seed = crc32(tables.empty() ? nullptr : &tables[0], tables.size());
+	return _seed;
 }
 
+//v3 file, tables then any appended entries
+void Score::loadPortable(const std::vector<unsigned char> &buf)
+{
+	const size_t tablesEnd = 2 + 4 + SCORE_TABLES * SCORE_ENTRIES * SCORE_ENTRY_BYTES;
+	if (buf.size() < tablesEnd + 4 || getU32(&buf[2]) != SCORE_TABLES ||
+		crc32(&buf[0], tablesEnd) != getU32(&buf[tablesEnd]))
+	{
+		std::cerr << "Score file " << _scorefile << " is damaged, starting a new one" << std::endl;
+		return;
+	}
+
+	const unsigned char *p = &buf[6];
+	for (int t = 0; t < SCORE_TABLES; ++t)
+		for (int item = 0; item < SCORE_ENTRIES; ++item, p += SCORE_ENTRY_BYTES)
+			getEntry(p, table(t)->level[item]);
+
+	size_t pos = tablesEnd + 4;
+	for ( ; pos + SCORE_RECORD_BYTES <= buf.size(); pos += SCORE_RECORD_BYTES)
+	{
+		const unsigned char *r = &buf[pos];
+		if (r[0] != SCORE_APPEND || r[3] >= SCORE_ENTRIES ||
+			crc32(r, SCORE_RECORD_BYTES - 4) != getU32(r + SCORE_RECORD_BYTES - 4))
+			break;
+		HiScoreEntry e;
+		getEntry(r + 4, e);
+		insert(r[1], r[2], r[3], e);
+		++_journal;
+	}
+	_pending.clear();	//replayed, not new
+
+	//only append after a clean end, otherwise the next save rewrites it all
+	_bCanAppend = (pos == buf.size());
+	if (!_bCanAppend)
+		std::cerr << "Score file " << _scorefile << " has a damaged last entry, ignored" << std::endl;
+}
+
+//new entries are appended to the file when they can be, otherwise (and every
+//so often, to keep it small) the whole file is written to a temp file which
+//then replaces the old one
 void Score::save(const std::string &scorefile)
 {
-	if (!scorefile.empty())
-        _scorefile = scorefile; //use passed in and make default
+	if (!scorefile.empty() && scorefile != _scorefile)
+	{
+		_scorefile = scorefile; //use passed in and make default
+		_bCanAppend = false;
+	}
 
 	std::cout << "Saving score file: " << _scorefile << std::endl;
 
-	try
+	if (_bCanAppend && !_pending.empty() && _journal + _pending.size() <= SCORE_JOURNAL_MAX)
 	{
-		std::ofstream out(_scorefile.c_str(), std::ios::out | std::ifstream::binary);
-
-		if (!out) 
+		std::vector<unsigned char> buf;
+		for (auto &a : _pending)
 		{
-			char err[1024] = { 0 };
-#ifdef _WIN32
-			strerror_s(err, errno);
-#else
-			strerror_r(errno, err, 1024);
-#endif
-			throw std::exception(err);
+			const size_t start = buf.size();
+			buf.push_back(SCORE_APPEND);
+			buf.push_back(a.mode);
+			buf.push_back(a.diff);
+			buf.push_back(a.pos);
+			putEntry(buf, a.entry);
+			putU32(buf, crc32(&buf[start], buf.size() - start));
 		}
-
+		std::ofstream out(_scorefile.c_str(), std::ios::out | std::ios::binary | std::ios::app);
+		out.write(reinterpret_cast<const char*>(&buf[0]), buf.size());
+		out.flush();
 		if (out)
 		{
-			out.put(0x00);	//format: 0x00 byte first denotes >= v0.4 score file
-			out.put(0x02);	//version: 0x02 denotes 2nd generation format
-
-			int diff;
-			for (diff = 0; diff < 3; ++diff)	//3 levels easy, med, hard
-				out.write(reinterpret_cast<char*>(&_hiScore[diff]), sizeof(_hiScore[0]));		//Reword
-
-			//from v0.4, speeder and TimeTrial included in scores
-			for (diff = 0; diff < 3; ++diff)
-				out.write(reinterpret_cast<char*>(&_hiScoreS6[diff]), sizeof(_hiScoreS6[0]));	//Speeder
-			for (diff = 0; diff < 3; ++diff)
-				out.write(reinterpret_cast<char*>(&_hiScoreTT[diff]), sizeof(_hiScoreTT[0]));	//TimeTrial
-
-			//from v0.6, arcade mode
-			for (diff = 0; diff < 3; ++diff)
-				out.write(reinterpret_cast<char*>(&_hiScoreRA[diff]), sizeof(_hiScoreRA[0]));	//Arcade
+			_journal += _pending.size();
+			_pending.clear();
+			return;
 		}
+		//else try writing the lot
+	}
+
+	try
+	{
+		std::vector<unsigned char> buf;
+		buf.push_back(0x00);	//format: 0x00 byte first denotes >= v0.4 score file
+		buf.push_back(SCORE_FORMAT);
+		putU32(buf, SCORE_TABLES);
+		writeTables(buf);
+		putU32(buf, crc32(&buf[0], buf.size()));
+
+		std::string error;
+		if (!ppfile::writeFileAtomic(_scorefile, &buf[0], buf.size(), error))
+			throw std::runtime_error(error);
+
+		_bCanAppend = true;
+		_journal = 0;
+		_pending.clear();
 	}
 	catch (std::exception & e)
 	{
@@ -312,6 +426,14 @@ void Score::insert(int mode, int diff, int level, HiScoreEntry &scoreEntry)
 				sizeof(HiScoreEntry));
 	//copy "curr" inits, score and words to correct hi score table
 	memcpy(&pScore->level[level], &scoreEntry, sizeof(HiScoreEntry));
+
+	//to append to the file on the next save()
+	SScoreAppend a;
+	a.mode = (Uint8)mode;
+	a.diff = (Uint8)diff;
+	a.pos = (Uint8)level;
+	a.entry = scoreEntry;
+	_pending.push_back(a);
 }
 
 std::string Score::inits(int mode, int diff, int level)
@@ -372,48 +494,158 @@ QuickState::QuickState()
 #endif
 }
 
+//snapshot file, little endian like the score file:
+//	"RWQS", version, then the tQuickStateSave fields and a crc32 of the lot
+static const char QS_MAGIC[] = "RWQS";
+static const unsigned char QS_VERSION = 2;	//2 added the challenge key
+
+static void putStr(std::vector<unsigned char> &out, const std::string &str)
+{
+	const size_t len = std::min<size_t>(str.length(), 0xFFFF);
+	out.push_back(len & 0xFF);
+	out.push_back((len >> 8) & 0xFF);
+	out.insert(out.end(), str.begin(), str.begin() + len);
+}
+
+//reads fields in turn, and just fails from the first one that runs off the end
+struct SReader
+{
+	SReader(const std::vector<unsigned char> &buf, size_t end) : _buf(buf), _pos(0), _end(end), _bOk(true) {}
+	const unsigned char *take(size_t n)
+	{
+		if (!_bOk || _pos + n > _end) { _bOk = false; return nullptr; }
+		const unsigned char *p = &_buf[_pos];
+		_pos += n;
+		return p;
+	}
+	Uint32 u32() { const unsigned char *p = take(4); return p ? getU32(p) : 0; }
+	unsigned char u8() { const unsigned char *p = take(1); return p ? *p : 0; }
+	std::string str()
+	{
+		const unsigned char *p = take(2);
+		const size_t len = p ? (p[0] | (p[1] << 8)) : 0;
+		const unsigned char *s = take(len);
+		return s ? std::string(reinterpret_cast<const char*>(s), len) : std::string();
+	}
+
+	const std::vector<unsigned char> &_buf;
+	size_t	_pos, _end;
+	bool	_bOk;
+};
+
 bool QuickState::quickStateSave()
 {
 	//quick save state for restore:
 	//score, words, dictionary shuffle seed, game type, game diff, dict file,
- 	std::ofstream outfile(_quickstatefile.c_str(), std::ios::out|std::ifstream::trunc);
-	if (outfile.is_open())
+	//and the level being played if saved part way through one
+	const tQuickStateSave &q = _qStateSave;
+	std::vector<unsigned char> buf(QS_MAGIC, QS_MAGIC + 4);
+	buf.push_back(QS_VERSION);
+	putStr(buf, q._wordfile);
+	putU32(buf, q._words);
+	putU32(buf, q._score);
+	putU32(buf, q._diff);
+	putU32(buf, q._mode);
+	putU32(buf, q._seed);
+	putU32(buf, q._challenge);
+	buf.push_back(q._bLevel ? 1 : 0);
+	if (q._bLevel)
+	{
+		putU32(buf, q._position);
+		putStr(buf, q._target);
+		putStr(buf, q._letters);
+		putU32(buf, q._countdown);
+		putU32(buf, q._countStart);
+		putU32(buf, (Uint32)q._found.size());
+		std::vector<unsigned char> bits((q._found.size() + 7) / 8, 0);
+		for (size_t n = 0; n < q._found.size(); ++n)
+			if (q._found[n]) bits[n / 8] |= 1 << (n % 8);
+		buf.insert(buf.end(), bits.begin(), bits.end());
+	}
+	putU32(buf, crc32(&buf[0], buf.size()));
+
+	//written whole then renamed, so there's never half a snapshot to resume
+	std::string error;
+	if (!ppfile::writeFileAtomic(_quickstatefile, &buf[0], buf.size(), error))
 	{
-		outfile << "wordfile=" << _qStateSave._wordfile << std::endl;
-		outfile << "words=" << _qStateSave._words << std::endl;
-		outfile << "score=" << _qStateSave._score << std::endl;
-		outfile << "diff=" << _qStateSave._diff << std::endl;
-		outfile << "mode=" << _qStateSave._mode << std::endl;
-		outfile << "seed=" << _qStateSave._seed << std::endl;
+		std::cerr << "Cannot save quick save file: " << error << std::endl;
+		return false;
 	}
 	return true;
 }
 
 bool QuickState::quickStateLoad()
+{
+	std::ifstream infile (_quickstatefile.c_str(), std::ios_base::in | std::ios_base::binary);
+	if (!infile.is_open())
+		return false;
+
+	std::vector<unsigned char> buf;
+	buf.assign(std::istreambuf_iterator<char>(infile), std::istreambuf_iterator<char>());
+	if (buf.size() < 5 || memcmp(&buf[0], QS_MAGIC, 4) != 0)
+	{
+		infile.clear();
+		infile.seekg(0, std::ios::beg);
+		return loadText(infile);
+	}
+
+	if (buf.size() < 9 || buf[4] < 1 || buf[4] > QS_VERSION ||
+		crc32(&buf[0], buf.size() - 4) != getU32(&buf[buf.size() - 4]))
+	{
+		std::cerr << "Quick save file " << _quickstatefile << " is damaged or too new, not resumed" << std::endl;
+		return false;
+	}
+
+	tQuickStateSave q;
+	SReader in(buf, buf.size() - 4);
+	in.take(5);
+	q._wordfile = in.str();
+	q._words = in.u32();
+	q._score = in.u32();
+	q._diff = in.u32();
+	q._mode = in.u32();
+	q._seed = in.u32();
+	if (buf[4] >= 2)
+		q._challenge = in.u32();
+	q._bLevel = in.u8() != 0;
+	if (q._bLevel)
+	{
+		q._position = in.u32();
+		q._target = in.str();
+		q._letters = in.str();
+		q._countdown = in.u32();
+		q._countStart = in.u32();
+		const Uint32 nFound = in.u32();
+		const unsigned char *bits = in.take((nFound + 7) / 8);
+		for (Uint32 n = 0; bits && n < nFound; ++n)
+			q._found.push_back((bits[n / 8] >> (n % 8)) & 1);
+	}
+	if (!in._bOk)
+		return false;
+	_qStateSave = q;
+	return true;
+}
+
+bool QuickState::loadText(std::ifstream &infile)
 {
 	std::string line, key, value;
-	std::ifstream infile (_quickstatefile.c_str(), std::ios_base::in);
-	if (infile.is_open())
+	while (std::getline(infile, line, '\n'))
 	{
-		while (std::getline(infile, line, '\n'))
-		{
-			pptxt::splitKeyValuePair(line, key, value);
-			if (key == "wordfile")
-				_qStateSave._wordfile = value;
-			else if (key == "words")
-				_qStateSave._words = atoi(value.c_str());
-			else if (key == "score")
-				_qStateSave._score = atoi(value.c_str());
-			else if (key == "diff")
-				_qStateSave._diff = atoi(value.c_str());
-			else if (key == "mode")
-				_qStateSave._mode = atoi(value.c_str());
-			else if (key == "seed")
-				_qStateSave._seed = atoi(value.c_str());
-		}
-		return true;
+		pptxt::splitKeyValuePair(line, key, value);
+		if (key == "wordfile")
+			_qStateSave._wordfile = value;
+		else if (key == "words")
+			_qStateSave._words = atoi(value.c_str());
+		else if (key == "score")
+			_qStateSave._score = atoi(value.c_str());
+		else if (key == "diff")
+			_qStateSave._diff = atoi(value.c_str());
+		else if (key == "mode")
+			_qStateSave._mode = atoi(value.c_str());
+		else if (key == "seed")
+			_qStateSave._seed = atoi(value.c_str());
 	}
-	return false;
+	return true;
 }
 
 //return true if .quickState.save file exists
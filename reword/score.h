@@ -7,6 +7,7 @@
 #include <string>
 #include <fstream>
 #include <ios>
+#include <vector>
 
 #include "states.h"
 
@@ -18,26 +19,7 @@ const int SCORE_WORD6 = 20;		//for all all-letter letter words
 const int SCORE_WORD = 10;		//for each non all-letter word
 const int SCORE_FASTEST = 2;	//each time a speeder or TT word is got faster than before
 
-//Make sure it's always the same packing
-//This is not portable over different endian systems but will at least
-//play nicer on most. If I need to be truly cross platform with the score
-//file, it needs to have its own serializer or be text (XML/JSON/INI etc?)
-#pragma pack(push, 1)
-
-struct HiScoreEntryPre04
-{
-    HiScoreEntryPre04() : words(0), score(0) { memset(inits, 0, 4); }
-	char	inits[4];	//3 letters + \0
-	Uint32	words;
-	Uint32	score;
-};		//pre v0.4 score format
-
-struct HiScoreLevelsPre04
-{
-	//1 more than (10) to display, to allow insert when adding inits at last pos in table
-	HiScoreEntryPre04 level[11];
-};
-
+//the score file is written a field at a time (see score.cpp), not as these structs
 struct HiScoreEntry
 {
     HiScoreEntry() : words(0), score(0), fastest(0), ttSeconds(0) { memset(inits, 0, 4); }
@@ -54,9 +36,6 @@ struct HiScoreLevels
 	HiScoreEntry level[11];
 };
 
-//back to whatever the platform uses
-#pragma pack(pop)
-
 class Score
 {
 public:
@@ -97,10 +76,23 @@ public:
 
 protected:
 	HiScoreLevels * getLevel(int mode, int diff);
+	HiScoreLevels * table(int t);	//0..11 in score file order
+	void writeTables(std::vector<unsigned char> &out);
+	void loadPortable(const std::vector<unsigned char> &buf);
 
 protected:
 	std::string		_scorefile;
 
+	//entries inserted since the last save, appended to the file by save()
+	struct SScoreAppend
+	{
+		Uint8			mode, diff, pos;
+		HiScoreEntry	entry;
+	};
+	std::vector<SScoreAppend>	_pending;
+	bool			_bCanAppend;	//file on disk is a complete v3 one
+	size_t			_journal;		//entries appended to it so far
+
 	HiScoreEntry	_curr;			//current score, words and inits to save to scoretable
 	HiScoreLevels	_hiScoreRA[3];	//Reword Arcade - 3 difficulties (easy, med, hard) of 10x hi scores
 	HiScoreLevels	_hiScore[3];	//Reword - 3 difficulties (easy, med, hard) of 10x hi scores
@@ -113,13 +105,24 @@ protected:
 //structure to hold quick save state between levels (for restore)
 typedef struct qss
 {
-    qss() : _words(0), _score(0), _diff(0), _mode(0), _seed(0) {}
+    qss() : _words(0), _score(0), _diff(0), _mode(0), _seed(0), _challenge(0),
+        _bLevel(false), _position(0), _countdown(0), _countStart(0) {}
     std::string _wordfile;
 	Uint32	    _words;	//words found so far
 	Uint32	    _score;	//
 	Uint32	    _diff;	//easy,med,hard
 	Uint32	    _mode;	//game type rew,speed,TT
 	Uint32	    _seed;	//random seed to restore the word list in same order
+	Uint32	    _challenge;	//daily challenge key, 0 if not one (not in version 1 saves)
+
+	//the level in progress, if saved mid level (not in older text saves)
+	bool        _bLevel;
+	Uint32      _position;  //word list position, just after the level's word
+	std::string _target;    //the level's word
+	std::string _letters;   //roundel order
+	Uint32      _countdown; //seconds left
+	Uint32      _countStart;    //countdown at the level start (for fastest times)
+	std::vector<bool> _found;   //words in the target found, in Words order
 } tQuickStateSave;
 
 class QuickState
@@ -134,6 +137,8 @@ public:
 	void getQuickState(tQuickStateSave &qss);
 
 protected:
+	bool loadText(std::ifstream &infile);	//pre snapshot saves
+
 	std::string		_quickstatefile;
  	tQuickStateSave	_qStateSave;
 
@@ -41,18 +41,38 @@ int Screen::_height = 0;
 int Screen::_width = 0;
 
 Screen::Screen() :
-    _window(nullptr), _renderer(nullptr), _texture(nullptr),
+    _window(nullptr), _renderer(nullptr), _texture(nullptr), _offscreen(nullptr),
     _init(false)
 {
 }
 
 // Construct 16 bit colour screen of given size
-Screen::Screen(int w, int h, const std::string &strTitle) :
-    _window(nullptr), _renderer(nullptr), _texture(nullptr),
+//If headless, no window is opened and everything is drawn by the software
+//renderer into an offscreen surface, so no video driver or display is needed
+Screen::Screen(int w, int h, const std::string &strTitle, bool bHeadless /*= false*/, bool bVsync /*= false*/) :
+    _window(nullptr), _renderer(nullptr), _texture(nullptr), _offscreen(nullptr),
     _init(false)
 {
 	assert(!(w<320 || h<240));	//reasonable minimum for existing game graphics etc
 
+	if (bHeadless)
+	{
+		_offscreen = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_ARGB8888);
+		if (_offscreen) _renderer = SDL_CreateSoftwareRenderer(_offscreen);
+		if (_renderer != nullptr)
+		{
+			std::cout << "Using headless software renderer" << std::endl;
+			_texture = SDL_CreateTexture(_renderer, SDL_PIXELFORMAT_ARGB8888,
+										 SDL_TEXTUREACCESS_STREAMING, w, h);
+			_width = w;
+			_height = h;
+			_init = (_texture != nullptr);
+		}
+		if (!_init)
+			setLastError("Unable to create headless screen");
+		return;
+	}
+
 	_window = SDL_CreateWindow(strTitle.c_str(),
                             SDL_WINDOWPOS_CENTERED_DISPLAY(0),
                             SDL_WINDOWPOS_CENTERED_DISPLAY(0),
@@ -67,11 +87,11 @@ Screen::Screen(int w, int h, const std::string &strTitle) :
 #endif
 
         //create screen renderer
-        _renderer = SDL_CreateRenderer(_window, -1, SDL_RENDERER_ACCELERATED);
+        _renderer = SDL_CreateRenderer(_window, -1, SDL_RENDERER_ACCELERATED | (bVsync ? SDL_RENDERER_PRESENTVSYNC : 0));
         if (_renderer == nullptr)
 		{
 			setLastError("Unable to create accelerated renderer - trying software renderer");
-	        _renderer = SDL_CreateRenderer(_window, -1, SDL_RENDERER_SOFTWARE);
+	        _renderer = SDL_CreateRenderer(_window, -1, SDL_RENDERER_SOFTWARE | (bVsync ? SDL_RENDERER_PRESENTVSYNC : 0));
 		}
 
         if (_renderer != nullptr)
@@ -106,6 +126,7 @@ Screen::~Screen()
     SDL_DestroyTexture(_texture);
     SDL_DestroyRenderer(_renderer);
     SDL_DestroyWindow(_window);
+    SDL_FreeSurface(_offscreen);
 }
 
 // Lock screen
@@ -139,6 +160,17 @@ void Screen::clear()
     SDL_RenderClear(_renderer);
 }
 
+//redirect drawing into a texture created by Texture::createTarget()
+bool Screen::setTarget(Texture* target)
+{
+    if (SDL_SetRenderTarget(_renderer, target ? target->texture_sdl() : nullptr) != 0)
+    {
+        std::cerr << "Failed to set render target : " << SDL_GetError() << std::endl;
+        return false;
+    }
+    return true;
+}
+
 // Draw a filled/solid rectangle
 void Screen::drawSolidRect (int x, int y, int w, int h, const SDL_Color& c)
 {
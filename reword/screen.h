@@ -12,7 +12,7 @@ class Screen : public Error //, public Surface
 public:
     // Construct 16 bit colour screen of given size
     Screen ();
-    Screen (int w, int h, const std::string &strTitle);
+    Screen (int w, int h, const std::string &strTitle, bool bHeadless = false, bool bVsync = false);
     ~Screen();
 
     SDL_Texture * texture() { return _texture; }
@@ -27,6 +27,8 @@ public:
     void drawSolidRectA(int x, int y, int w, int h, const SDL_Color& c, int iAlpha);
     void putPixel(int x, int y, Uint32 colour);
 
+    bool setTarget(Texture* target);    //draw into target texture, nullptr for the screen again
+
     Rect blit(SDL_Texture* source, SDL_Rect* srcRect, int destX, int destY);
     Rect blit(Texture* srcTex, SDL_Rect* srcRect, int destX, int destY);
     Rect blit_mid(Texture* srcTex, SDL_Rect* srcRect, int destDeltaX, int destY, bool bAbsolute = false);
@@ -45,6 +47,7 @@ private:
 	SDL_Window      * _window;
 	SDL_Renderer    * _renderer;
 	SDL_Texture     * _texture;
+	SDL_Surface     * _offscreen;   //headless, software renderer draws here instead of a window
 
 	bool    	    _init;
 };
@@ -43,16 +43,16 @@ Licence:		This program is free software; you can redistribute it and/or modify
 #include "sprite.h"
 #include "screen.h"
 #include "utils.h"
+#include "locator.h"
 #include <math.h>
 
-//extern static RandInt g_randInt;
 
 Sprite::Sprite() :
 	ImageAnim(),
 	_xStart(0), _yStart(0), _xEnd(0), _yEnd(0),
 	_xDir(0), _yDir(0), _xVel(0), _yVel(0), _type(Sprite::SPR_NONE),
 	_pauseM(true), _loopM(false), _rateM(0), _waitM(0), _touchable(true),
-	_bEase(false)
+	_bEase(false), _easeX(0), _easeY(0)
 {
 }
 
@@ -61,7 +61,7 @@ Sprite::Sprite(std::string fileName, bool bAlpha, Uint32 nFrames) :
 	_xStart(0), _yStart(0), _xEnd(0), _yEnd(0),
 	_xDir(0), _yDir(0), _xVel(0), _yVel(0), _type(Sprite::SPR_NONE),
 	_pauseM(true), _loopM(false), _rateM(0), _waitM(0), _touchable(true),
-	_bEase(false)
+	_bEase(false), _easeX(0), _easeY(0)
 {
 }
 
@@ -70,8 +70,22 @@ Sprite::Sprite(tSharedImage &img) :
 	_xStart(0), _yStart(0), _xEnd(0), _yEnd(0),
 	_xDir(0), _yDir(0), _xVel(0), _yVel(0), _type(Sprite::SPR_NONE),
 	_pauseM(true), _loopM(false), _rateM(0), _waitM(0), _touchable(true),
-	_bEase(false)
+	_bEase(false), _easeX(0), _easeY(0)
 {
+}
+
+//a copy part way through an eased move carries on from the same place
+Sprite::Sprite(const Sprite &s) :
+	ImageAnim(s),
+	_bEase(false), _easeX(0), _easeY(0)
+{
+	*this = s;
+}
+
+Sprite::~Sprite()
+{
+	Locator::easing().release(_easeX);
+	Locator::easing().release(_easeY);
 }
 
 Sprite& Sprite::operator=(const Sprite &s)
@@ -97,6 +111,11 @@ Sprite& Sprite::operator=(const Sprite &s)
         this->_rateM = s._rateM;
         this->_waitM = s._waitM;
         this->_touchable = s._touchable;
+        this->_bEase = s._bEase;
+        Locator::easing().release(this->_easeX);
+        Locator::easing().release(this->_easeY);
+        this->_easeX = Locator::easing().copy(s._easeX);
+        this->_easeY = Locator::easing().copy(s._easeY);
     }
     return *this;
 }
@@ -154,15 +173,19 @@ void Sprite::easeMoveTo(int xEnd, int yEnd, Uint32 duration, Sint32 delay, Easin
 	_xEnd = xEnd;
 	_yEnd = yEnd;
 
-    _easeX.setup(ease, 0, getXPos(), xDiff, duration);
-    _easeY.setup(ease, 0, getYPos(), yDiff, duration);
-
 	//unpause movement if movement is set up correctly
 	pauseMove( false );		//set true to allow moving
 
     if (delay < 0)
-        delay = g_randInt.random(abs(delay));   //delay between 0-n where abs(delay) is max
+        delay = Locator::random().stream(RNG_EFFECTS).below(abs(delay));   //delay between 0-n where abs(delay) is max
     _waitM.start(0, delay);
+
+    //worked with all the others each frame, only on the axes that move
+    Easing &easing = Locator::easing();
+    easing.release(_easeX);
+    easing.release(_easeY);
+    _easeX = _xDir ? easing.add(ease, getXPos(), xDiff, duration, delay) : 0;
+    _easeY = _yDir ? easing.add(ease, getYPos(), yDiff, duration, delay) : 0;
 	setMoveLoop(false);	 //not repeat any timer/movement
 
 	_bEase = true;
@@ -225,6 +248,9 @@ void Sprite::startMoveTo(int xEnd, int yEnd,
 	if (rate && canMove()) setMoveRate(rate, delay);
 
     _bEase = false;
+    Locator::easing().release(_easeX);
+    Locator::easing().release(_easeY);
+    _easeX = _easeY = 0;
 }
 
 
@@ -234,16 +260,21 @@ void Sprite::work()
     {
         if (!_pauseM && _waitM.done(_loopM))
         {
-            if (_xDir && !_easeX.done()) _x = _easeX.work();
-            if (_yDir && !_easeY.done()) _y = _easeY.work();
+            //already moved on this frame by Game
+            Easing &easing = Locator::easing();
+            if (_easeX) _x = easing.value(_easeX);
+            if (_easeY) _y = easing.value(_easeY);
 
             //check if end of move reached
-            if ((!_xDir || ((_xDir>0 && _x >= _xEnd) || (_xDir<0 && _x <= _xEnd)) || (_easeX.done())) &&
-                (!_yDir || ((_yDir>0 && _y >= _yEnd) || (_yDir<0 && _y <= _yEnd)) || (_easeY.done())) )
+            if ((!_xDir || ((_xDir>0 && _x >= _xEnd) || (_xDir<0 && _x <= _xEnd)) || (easing.done(_easeX))) &&
+                (!_yDir || ((_yDir>0 && _y >= _yEnd) || (_yDir<0 && _y <= _yEnd)) || (easing.done(_easeY))) )
             {
                 _x = _xEnd;	//make sure it stops at the exact end point given
                 _y = _yEnd;
                 pauseMove();
+                easing.release(_easeX);
+                easing.release(_easeY);
+                _easeX = _easeY = 0;
 
                 //some use sig/slot
                 _sigEvent2(USER_EV_END_MOVEMENT, _objectId);
@@ -24,7 +24,8 @@ public:
 	Sprite();
 	Sprite(std::string fileName, bool bAlpha, Uint32 nFrames);
 	Sprite(tSharedImage &img);
-	virtual ~Sprite() {}
+	Sprite(const Sprite &s);
+	virtual ~Sprite();
 
 	Sprite& operator=(const Sprite &s);
 
@@ -83,7 +84,7 @@ private:
 	bool	_touchable;
 
 	bool    _bEase;
-	Easing  _easeX, _easeY;
+	Easing::tEaseId _easeX, _easeY;    //tweens in Locator::easing(), 0 if none
 
 };
 
@@ -5,14 +5,15 @@ File:			spritemgr.cpp
 
 Class impl:		SpriteMgr
 
-Description:	A container class for a list of sprites, to be updated regularly during
-				the work() / draw() cycle
-
-
-
-				##### WORK IN PROGRESS - CURRENTLY NOT (YET) USED IN REWORD #####
-
-
+Description:	Short lived animated effects (eg. the roundel press ping), updated
+				and drawn by the main game loop after each screen's own work()
+				and render().
+				A fixed pool of effects held as arrays of each value (image,
+				position, frame, next frame time) by slot. The active slots are
+				kept packed at the front of _active, so work() and draw() just
+				run down that, and finished slots go back on a free list for the
+				next add(). No allocation once constructed, however many effects
+				come and go.
 
 Author:			Al McLuckie (al-at-purplepup-dot-org)
 
@@ -36,17 +37,24 @@ Licence:		This program is free software; you can redistribute it and/or modify
 ////////////////////////////////////////////////////////////////////
 
 #include "spritemgr.h"
-
-#include "screen.h"
-#include "global.h"
+
+#include "screen.h"
+#include "global.h"
 #include "resource.h"
-
-//#include <iostream> //for debug msgs
-#include <cassert>
+#include "locator.h"
+
+//#include <iostream> //for debug msgs
+#include <cassert>
+#include <cmath>
 
 SpriteMgr::SpriteMgr() :
-	_handle(0)
+	_count(0), _free(MAX_EFFECTS), _handle(0)
 {
+	for (Uint32 i = 0; i < MAX_EFFECTS; ++i)
+	{
+		_freeList[i] = MAX_EFFECTS - 1 - i;	//slot 0 used first
+		_id[i] = 0;
+	}
 }
 
 SpriteMgr::~SpriteMgr()
@@ -56,147 +64,100 @@ SpriteMgr::~SpriteMgr()
 
 void SpriteMgr::clear()
 {
-	//delete all sprites previously added to the manager
-	for (_it = _sprmap.begin(); _it != _sprmap.end(); ++_it)
-	{
-	    del( (*_it).first );  //handle
-	}
-
+	while (_count)
+		remove(_count - 1);
 	_handle = 0;
 }
 
-//get a sprite pointer using the handle given
-Sprite * SpriteMgr::get(Uint32 handle)
+//add using image resource name and initial params to start anim etc.
+//Returns the effect handle, or 0 if the pool is full (effect dropped)
+Uint32 SpriteMgr::add(const std::string resource, int x, int y, Uint32 rate_ms, ImageAnim::eAnim anim)
 {
-	_it = _sprmap.find(handle);
-	if (_it == _sprmap.end()) return nullptr;
-	return (*_it).second._spr.get();
-}
-
-//add a sprite and return the (unique) allocated handle
-Uint32 SpriteMgr::add(t_pSharedSpr &pSpr)
-{
-	if (!pSpr.get()) return 0;
-
-    SpriteX sx;
-    sx._spr = pSpr;
-	_sprmap[++_handle] = sx;
-
-    pSpr->setObjectId(_handle);  //used to lookup spr after event return
-    pSpr->_sigEvent2.Connect(this, &SpriteMgr::SpriteEvent);
-
+    if (resource.empty())
+    {
+        assert(false);  //fail!
+        return 0;
+    }
+	if (!_free) return 0;
+
+	tSharedImage &img = Resource::image(resource);
+	if (!img.get() || !img->tileCount()) return 0;
+
+	const Uint32 slot = _freeList[--_free];
+	_active[_count++] = slot;
+
+	_image[slot] = img;
+	_x[slot] = (float)x;
+	_y[slot] = (float)y;
+	_frame[slot] = 0;
+	_lastFrame[slot] = img->tileCount() - 1;
+	_rate[slot] = rate_ms;
+	_due[slot] = Locator::clock().now() + rate_ms;
+	_anim[slot] = anim;
+	if (++_handle == 0) ++_handle;	//wrapped, skip 0
+	_id[slot] = _handle;
 	return _handle;
 }
-
-//add using image resource name and initial params to start anim etc
-Sprite * SpriteMgr::add(const std::string resource, int x, int y, Uint32 rate_ms, ImageAnim::eAnim anim)
-{
-    if (resource.empty())
-    {
-        assert(false);  //fail!
-        return 0;
-    }
-    t_pSharedSpr pSpr(new Sprite(Resource::image(resource)));
-
-    SpriteX sx;
-    sx._spr = pSpr;
-	_sprmap[++_handle] = sx;
-
-    pSpr->setObjectId(_handle);  //used to lookup spr after event return
-    pSpr->_sigEvent2.Connect(this, &SpriteMgr::SpriteEvent);
-
-    pSpr->startAnim( 0, -1, anim, rate_ms);
-    pSpr->setPos(x, y);
-
-	return pSpr.get();
-}
 
 bool SpriteMgr::del(Uint32 handle)
 {
-	t_SprMap::iterator it = _sprmap.find(handle);
-	return del(it);
+	if (!handle) return false;
+	for (Uint32 n = 0; n < _count; ++n)
+		if (_id[_active[n]] == handle)
+		{
+			remove(n);
+			return true;
+		}
+	return false;
 }
-
-bool SpriteMgr::del(t_SprMap::iterator it)
-{
-	if (it == _sprmap.end()) return false;
-
-    if ((*it).second._spr.get())
-    {
-        (*it).second._spr->_sigEvent2.Disconnect(this, &SpriteMgr::SpriteEvent);
-        (*it).second._spr.reset(); //delete
-    }
-	_sprmap.erase(it);
-	return true;
-}
-
-
-void SpriteMgr::work(Uint32 handle)
-{
-   	t_SprMap::iterator it = _sprmap.find(handle);
-	if (it == _sprmap.end()) return;
-
-    if ((*it).second._bDead)
-    {
-        del(it);
-        return;
-    }
-
-	//find actual sprite and update it
-	Sprite *s = (*it).second._spr.get();
-	if (s)
-	{
-        s->work();
-	}
+
+//take the n'th active effect out, filling its place with the last one
+void SpriteMgr::remove(Uint32 n)
+{
+	assert(n < _count);
+	const Uint32 slot = _active[n];
+	_active[n] = _active[--_count];
+	_image[slot].reset();
+	_id[slot] = 0;
+	_freeList[_free++] = slot;
 }
 
+//step each effect's frame when due. The once types end on their last
+//frame, as ImageAnim does, so that is shown for a full rate period
 void SpriteMgr::work(void)
 {
-	//update all in map
-	_itend = _sprmap.end();
-	for (_it = _sprmap.begin(); _it != _itend; ++_it)
+	const Uint32 now = Locator::clock().now();
+	for (Uint32 n = 0; n < _count; )
 	{
-        if ((*_it).second._bDead)
-        {
-            del(_it);
-            return;
-        }
-
-        (*_it).second._spr->work();
+		const Uint32 slot = _active[n];
+		if ((Sint32)(now - _due[slot]) < 0 || ImageAnim::ANI_NONE == _anim[slot])
+		{
+			++n;
+			continue;
+		}
+		_due[slot] = now + _rate[slot];
+
+		if (_frame[slot] < _lastFrame[slot])
+			++_frame[slot];
+		else if (ImageAnim::ANI_LOOP == _anim[slot])
+			_frame[slot] = 0;
+		else if (ImageAnim::ANI_ONCEPAUSE == _anim[slot])
+			_anim[slot] = ImageAnim::ANI_NONE;	//hold the last frame
+		else
+		{
+			remove(n);	//ANI_ONCEDEL or ANI_ONCEHIDE, n is now the moved last one
+			continue;
+		}
+		++n;
 	}
 }
 
-void SpriteMgr::draw(Uint32 handle, Screen* screen)
-{
-	//find actual sprite and draw it
-	Sprite *s = get(handle);
-	if (s) s->draw(screen);
-}
-
 void SpriteMgr::draw(Screen* screen)
 {
-	//draw all in map
-	_itend = _sprmap.end();
-	for (_it = _sprmap.begin(); _it != _itend; ++_it)
-	{
-        if ((*_it).second._spr.get())
-            (*_it).second._spr->draw(screen);
+	for (Uint32 n = 0; n < _count; ++n)
+	{
+		const Uint32 slot = _active[n];
+		SDL_Rect rect = _image[slot]->tileRect(_frame[slot]);
+		screen->blit(_image[slot]->texture(), &rect, (int)round(_x[slot]), (int)round(_y[slot]));
 	}
 }
-
-void SpriteMgr::SpriteEvent(int event, int spr_id)
-{
-    if (event == USER_EV_END_DELETE)
-    {
-        //remove the sprite from the map
-        t_SprMap::iterator it = _sprmap.find(spr_id);
-        if (it == _sprmap.end()) return;
-
-        (*it).second._bDead = true;    //delete next work cycle
-    }
-}
-
-
-
-
-
@@ -3,50 +3,46 @@
 #if !defined _SPRITEMGR_H
 #define _SPRITEMGR_H
 
-#include "sprite.h"
+#include "imageanim.h"
+
+#include <string>
+
+class Screen;
 
-#include <map>
-
-class Screen;
-
 class SpriteMgr
 {
-public:
-    struct SpriteX
-    {
-        SpriteX() : _bDead(false) {}
-        bool            _bDead;
-        t_pSharedSpr   _spr;
-    };
-
-	typedef std::map <Uint32, SpriteX> t_SprMap;
+public:
+	enum { MAX_EFFECTS = 256 };		//any more at once are dropped
 
 	SpriteMgr();
 	~SpriteMgr();
 
 	void clear();
 
-	Sprite *    get(Uint32 handle);
-	Uint32	 	add(t_pSharedSpr &pSpr);
-	Sprite *    add(const std::string resource, int x=0, int y=0, Uint32 rate_ms=25, ImageAnim::eAnim anim=ImageAnim::ANI_ONCEDEL);
+	Uint32	 	add(const std::string resource, int x=0, int y=0, Uint32 rate_ms=25, ImageAnim::eAnim anim=ImageAnim::ANI_ONCEDEL);
 	bool		del(Uint32 handle);
-    bool        del(t_SprMap::iterator it);
+	Uint32		size() const { return _count; }
 
-	void		work(Uint32 handle);
-	void		work(void);				//for all sprites
-	void		draw(Uint32 handle, Screen* screen);
-	void		draw(Screen* screen);	//for all sprites
-
-    void        SpriteEvent(int event, int spr_id);
+	void		work(void);				//for all effects
+	void		draw(Screen* screen);	//for all effects
 
 private:
-	t_SprMap	_sprmap;
-	Uint32  	_handle;
-
-    //some iterators for use in updates
-	t_SprMap::iterator _it;	    //not thread safe (but we're not using threads so...)
-	t_SprMap::iterator _itend;	//not thread safe
+	void		remove(Uint32 n);		//n'th active effect
+
+	//by slot
+	tSharedImage		_image[MAX_EFFECTS];
+	float				_x[MAX_EFFECTS], _y[MAX_EFFECTS];
+	Uint32				_frame[MAX_EFFECTS], _lastFrame[MAX_EFFECTS];
+	Uint32				_rate[MAX_EFFECTS];	//ms between frames
+	Uint32				_due[MAX_EFFECTS];	//time of the next frame
+	ImageAnim::eAnim	_anim[MAX_EFFECTS];
+	Uint32				_id[MAX_EFFECTS];	//handle, 0 if free
+
+	Uint32		_active[MAX_EFFECTS];	//slots in use, the first _count
+	Uint32		_count;
+	Uint32		_freeList[MAX_EFFECTS];	//slots not in use, the first _free
+	Uint32		_free;
+	Uint32  	_handle;				//last handed out
 };
 
 #endif //_SPRITEMGR_H
-
@@ -106,22 +106,42 @@ bool Surface::load(const std::string &fileName)
     //then add RES_IMAGES prefix automatically. So callers can just use base filename or
     //add own explicit path.
     const bool bHasPath = (fileName.find_first_of("\\/") != std::string::npos);
-    if (bHasPath)
-        _surface = IMG_Load(fileName.c_str());		//using SDL_Image dll (png, jpg etc)
-    else
-        _surface = IMG_Load((RES_IMAGES + fileName).c_str());		//using SDL_Image dll (png, jpg etc)
+    const std::string fullName = bHasPath ? fileName : (RES_IMAGES + fileName);
+
+    //already decoded in the baked asset pack?
+    _surface = Resource::pack().getSurface(fullName);
+    if (_surface)
+        return true;
+
+    //decoded on a loader thread while starting up, else load it now
+    _surface = Resource::loader().takeImage(fullName);
+    if (nullptr == _surface)
+    {
+        _surface = IMG_Load(fullName.c_str());		//using SDL_Image dll (png, jpg etc)
+    }
 	if (nullptr == _surface)
 	{
-		std::cerr << "Failed to load image " << (bHasPath?"":(RES_IMAGES).c_str()) << fileName << ". Cannot start." << std::endl;
+		std::cerr << "Failed to load image " << fullName << ". Cannot start." << std::endl;
 		std::cerr << "SDL_Error = " << SDL_GetError() << std::endl;
 		return false;
 	}
+    Resource::pack().putSurface(fullName, _surface);    //only if baking
 
     SDL_SetSurfaceBlendMode(_surface, SDL_BLENDMODE_BLEND);  //this is default anyway
 
     return true;
 }
 
+bool Surface::clone(SDL_Surface *s)
+{
+    cleanUp();
+    _surface = SDL_ConvertSurface(s, s->format, 0);
+    if (nullptr == _surface)
+        return false;
+    SDL_SetSurfaceBlendMode(_surface, SDL_BLENDMODE_BLEND);
+    return true;
+}
+
 void Surface::setTransparentColour(SDL_Color cAlphaKey)
 {
     if (_surface == nullptr) return;
@@ -272,6 +292,20 @@ void Texture::createFrom(Surface &surface)
     _width = w;
     _height = h;
 }
+bool Texture::createTarget(Uint32 w, Uint32 h)
+{
+    cleanup();
+    _texture = SDL_CreateTexture(Locator::screen().renderer(), SDL_PIXELFORMAT_RGBA8888,
+                                 SDL_TEXTUREACCESS_TARGET, w, h);
+    if (nullptr == _texture)
+    {
+        std::cerr << "Failed to create target texture : " << SDL_GetError() << std::endl;
+        return false;
+    }
+    _width = w;
+    _height = h;
+    return true;
+}
 void Texture::cleanup()
 {
     if (_texture)
@@ -32,6 +32,7 @@ public:
 
 	bool create(Uint32 w, Uint32 h, int iAlpha = -1);	//create a surface of specific size
     bool load(const std::string &fileName);
+    bool clone(SDL_Surface *s);     //deep copy of the pixels
 	void copy(Surface &s);
 
     void setTransparentColour(SDL_Color cAlphaKey);
@@ -62,6 +63,7 @@ public:
     Texture();
     Texture(Surface &surface);
     void createFrom(Surface &surface);
+    bool createTarget(Uint32 w, Uint32 h);  //blank texture the renderer can draw into
     virtual ~Texture();
     void cleanup();
 
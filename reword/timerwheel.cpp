@@ -0,0 +1,127 @@
+////////////////////////////////////////////////////////////////////
+/*
+
+File:			timerwheel.cpp
+
+Class impl:		TimerWheel
+
+Description:	Single threaded timers for the game loop. Timers hash into a
+				ring of slots by due time, so each tick only looks at the
+				slots that time has passed over since the last one, not every
+				timer. Anything more than a turn of the wheel away just stays in
+				its slot until its round comes up.
+				Replaces SDL_AddTimer() for the game countdown, which ran on
+				SDL's timer thread and had to talk to the game by pushing events.
+
+Licence:		This program is free software; you can redistribute it and/or modify
+				it under the terms of the GNU General Public License as published by
+				the Free Software Foundation; either version 2 of the License, or
+				(at your option) any later version.
+
+				This software is distributed in the hope that it will be useful,
+				but WITHOUT ANY WARRANTY; without even the implied warranty of
+				MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+				GNU General Public License for more details.
+
+				You should have received a copy of the GNU General Public License
+				along with this program; if not, write to the Free Software
+				Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+////////////////////////////////////////////////////////////////////
+
+#include "timerwheel.h"
+#include "locator.h"
+
+#include <algorithm>
+
+TimerWheel::TimerWheel() :
+	_now(0), _nextId(0), _firing(0), _bFiringCancelled(false)
+{
+}
+
+TimerWheel::tTimerId TimerWheel::add(Uint32 interval, tTimerFn fn)
+{
+	if (++_nextId == 0) ++_nextId;	//wrapped, skip 0
+	STimer &t = _timers[_nextId];
+	t.due = Locator::clock().now() + interval;
+	t.fn = fn;
+	schedule(_nextId, t.due);
+	return _nextId;
+}
+
+bool TimerWheel::cancel(tTimerId id)
+{
+	if (id && id == _firing)
+	{
+		_bFiringCancelled = true;	//tick() removes it once the callback returns
+		return true;
+	}
+	return _timers.erase(id) != 0;	//its slot entry is dropped when next reached
+}
+
+void TimerWheel::clear()
+{
+	_timers.clear();
+	for (auto &slot : _slots)
+		slot.clear();
+	_bFiringCancelled = (_firing != 0);
+}
+
+//anything already overdue goes in the current slot, so it's seen next tick
+void TimerWheel::schedule(tTimerId id, Uint32 due)
+{
+	const Uint32 at = ((Sint32)(due - _now) < 0) ? _now : due;
+	_slots[(at / SLOT_MS) % SLOTS].push_back(id);
+}
+
+void TimerWheel::tick(Uint32 now)
+{
+	//slots passed since the last tick, the whole wheel at most
+	const Uint32 first = _now / SLOT_MS;
+	const Uint32 count = std::min<Uint32>(now / SLOT_MS - first + 1, SLOTS);
+	_now = now;
+
+	std::vector<std::pair<tTimerId, Uint32> > again;	//repeating timers, rescheduled after
+	for (Uint32 n = 0; n < count; ++n)
+	{
+		std::vector<tTimerId> &slot = _slots[(first + n) % SLOTS];
+		std::vector<tTimerId> due;
+		auto keep = slot.begin();
+		for (auto id : slot)
+		{
+			auto it = _timers.find(id);
+			if (it == _timers.end())
+				continue;							//cancelled
+			if ((Sint32)(it->second.due - now) > 0)
+				*keep++ = id;						//a later turn of the wheel
+			else
+				due.push_back(id);
+		}
+		slot.erase(keep, slot.end());
+
+		for (auto id : due)
+		{
+			auto it = _timers.find(id);
+			if (it == _timers.end())
+				continue;							//cancelled by an earlier callback
+			const tTimerFn fn = it->second.fn;		//callback may add or cancel timers
+			_firing = id;
+			_bFiringCancelled = false;
+			const Uint32 interval = fn();
+			_firing = 0;
+
+			it = _timers.find(id);
+			if (interval && !_bFiringCancelled && it != _timers.end())
+			{
+				it->second.due += interval;			//keep the cadence, like SDL timers
+				again.push_back(std::make_pair(id, it->second.due));
+			}
+			else
+				_timers.erase(id);
+		}
+	}
+
+	for (auto &a : again)
+		schedule(a.first, a.second);
+}
@@ -0,0 +1,50 @@
+//timerwheel.h
+//
+//Timers run by the main loop once a frame, on the game Clock. Like
+//SDL_AddTimer() the callback returns the interval to its next call (0 to
+//stop), but it runs on the main thread, between work() and the event
+//handling, so it can change the game state directly.
+
+#if !defined TIMERWHEEL_H
+#define TIMERWHEEL_H
+
+#include <SDL.h>
+
+#include <functional>
+#include <map>
+#include <vector>
+
+class TimerWheel
+{
+public:
+	typedef Uint32 tTimerId;				//0 is never a valid id
+	typedef std::function<Uint32()> tTimerFn;
+
+	TimerWheel();
+
+	tTimerId	add(Uint32 interval, tTimerFn fn);	//first call interval ms from now
+	bool		cancel(tTimerId id);				//ok to call from a callback, even its own
+	void		tick(Uint32 now);					//call anything due by now
+	void		clear();
+	size_t		size() const { return _timers.size(); }
+
+private:
+	enum { SLOTS = 64, SLOT_MS = 16 };		//a frame a slot, about a second a turn
+
+	struct STimer
+	{
+		Uint32		due;
+		tTimerFn	fn;
+	};
+
+	void		schedule(tTimerId id, Uint32 due);
+
+	std::map<tTimerId, STimer>	_timers;
+	std::vector<tTimerId>		_slots[SLOTS];	//ids by due time, cancelled ones dropped when reached
+	Uint32		_now;			//time of the last tick
+	tTimerId	_nextId;
+	tTimerId	_firing;		//callback running now
+	bool		_bFiringCancelled;
+};
+
+#endif //TIMERWHEEL_H
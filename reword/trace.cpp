@@ -0,0 +1,273 @@
+////////////////////////////////////////////////////////////////////
+/*
+
+File:			trace.cpp
+
+Class impl:		Trace
+
+Description:	Input record and replay. The file is a header then a stream of
+				one byte record types, each followed by its values as variable
+				length (7 bits per byte) ints:
+					frame	ms since the previous frame (and one before each
+							screen's init(), for the time taken loading it)
+					key		down/up + keycode
+					mouse	down/up + x, y
+					joy		down/up + button
+					seed	a Words::load() random seed
+					quit
+				So a few bytes a frame. Replay loads the whole file, then steps
+				the virtual clock by each frame's recorded time and pushes that
+				frame's events just before Game::play() polls for them. Timers
+				(the countdown) run from the main loop on the frame time, so
+				they fire on the same frames again and aren't recorded.
+
+Licence:		This program is free software; you can redistribute it and/or modify
+				it under the terms of the GNU General Public License as published by
+				the Free Software Foundation; either version 2 of the License, or
+				(at your option) any later version.
+
+				This software is distributed in the hope that it will be useful,
+				but WITHOUT ANY WARRANTY; without even the implied warranty of
+				MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+				GNU General Public License for more details.
+
+				You should have received a copy of the GNU General Public License
+				along with this program; if not, write to the Free Software
+				Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+////////////////////////////////////////////////////////////////////
+
+#include "trace.h"
+#include "global.h"
+#include "locator.h"
+
+#include <algorithm>
+#include <iostream>
+
+#define TRACE_MAGIC		"RWTR"
+#define TRACE_VERSION	3	//1 had countdown timer records, 2 no frame before each screen
+
+enum eTraceRecord
+{
+	TR_END = 0,
+	TR_FRAME,
+	TR_KEYDOWN,
+	TR_KEYUP,
+	TR_MOUSEDOWN,
+	TR_MOUSEUP,
+	TR_JOYDOWN,
+	TR_JOYUP,
+	TR_UNUSED,		//was countdown timer event
+	TR_SEED,
+	TR_QUIT
+};
+
+static void writeVar(std::ostream &out, Uint32 v)
+{
+	while (v >= 0x80)
+	{
+		out.put((char)((v & 0x7f) | 0x80));
+		v >>= 7;
+	}
+	out.put((char)v);
+}
+
+static bool readVar(std::istream &in, Uint32 &v)
+{
+	v = 0;
+	for (int shift = 0; shift < 35; shift += 7)
+	{
+		const int c = in.get();
+		if (c == EOF) return false;
+		v |= (Uint32)(c & 0x7f) << shift;
+		if (!(c & 0x80)) return true;
+	}
+	return false;	//corrupt, too long
+}
+
+Trace::Trace() : _last(0), _bReplay(false), _frame(0)
+{
+}
+
+Trace::~Trace()
+{
+	close();
+}
+
+bool Trace::record(const std::string &fileName)
+{
+	close();
+	_out.open(fileName.c_str(), std::ios::binary | std::ios::trunc);
+	if (!_out)
+	{
+		std::cerr << "Unable to create trace " << fileName << std::endl;
+		return false;
+	}
+	_out.write(TRACE_MAGIC, 4);
+	_out.put(TRACE_VERSION);
+	_last = Locator::clock().now();
+	std::cout << "Recording trace to " << fileName << std::endl;
+	return true;
+}
+
+bool Trace::replay(const std::string &fileName)
+{
+	close();
+	std::ifstream in(fileName.c_str(), std::ios::binary);
+	if (!in || !load(in))
+	{
+		std::cerr << "Unable to read trace " << fileName << std::endl;
+		_frames.clear();
+		_seeds.clear();
+		return false;
+	}
+	_bReplay = true;
+	_frame = 0;
+	std::cout << "Replaying trace " << fileName << " (" << _frames.size() << " frames)" << std::endl;
+	return true;
+}
+
+void Trace::close()
+{
+	if (_out.is_open())
+	{
+		_out.put(TR_END);
+		_out.close();
+	}
+	_bReplay = false;
+}
+
+bool Trace::load(std::istream &in)
+{
+	char magic[4];
+	if (!in.read(magic, 4) || std::string(magic, 4) != TRACE_MAGIC || in.get() != TRACE_VERSION)
+		return false;
+
+	_frames.clear();
+	_seeds.clear();
+	for (;;)
+	{
+		const int type = in.get();
+		if (type == EOF || type == TR_END)
+			return true;	//a crashed recording has no end record, replay what there is
+
+		Uint32 a = 0, b = 0;
+		SDL_Event event;
+		SDL_zero(event);
+		switch (type)
+		{
+		case TR_FRAME:
+			if (!readVar(in, a)) return false;
+			_frames.push_back(SFrame());
+			_frames.back().delta = a;
+			continue;
+		case TR_SEED:
+			if (!readVar(in, a)) return false;
+			_seeds.push_back(a);
+			continue;
+		case TR_KEYDOWN:
+		case TR_KEYUP:
+			if (!readVar(in, a)) return false;
+			event.type = (TR_KEYDOWN == type) ? SDL_KEYDOWN : SDL_KEYUP;
+			event.key.state = (TR_KEYDOWN == type) ? SDL_PRESSED : SDL_RELEASED;
+			event.key.keysym.sym = (SDL_Keycode)a;
+			break;
+		case TR_MOUSEDOWN:
+		case TR_MOUSEUP:
+			if (!readVar(in, a) || !readVar(in, b)) return false;
+			event.type = (TR_MOUSEDOWN == type) ? SDL_MOUSEBUTTONDOWN : SDL_MOUSEBUTTONUP;
+			event.button.state = (TR_MOUSEDOWN == type) ? SDL_PRESSED : SDL_RELEASED;
+			event.button.button = SDL_BUTTON_LEFT;
+			event.button.x = a;
+			event.button.y = b;
+			break;
+		case TR_JOYDOWN:
+		case TR_JOYUP:
+			if (!readVar(in, a)) return false;
+			event.type = (TR_JOYDOWN == type) ? SDL_JOYBUTTONDOWN : SDL_JOYBUTTONUP;
+			event.jbutton.state = (TR_JOYDOWN == type) ? SDL_PRESSED : SDL_RELEASED;
+			event.jbutton.button = (Uint8)a;
+			break;
+		case TR_QUIT:
+			event.type = SDL_QUIT;
+			break;
+		default:
+			return false;
+		}
+		if (_frames.empty()) return false;	//events always follow a frame
+		_frames.back().events.push_back(event);
+	}
+}
+
+Uint32 Trace::seed(Uint32 seed)
+{
+	if (isRecording())
+	{
+		_out.put(TR_SEED);
+		writeVar(_out, seed);
+	}
+	else if (_bReplay)
+	{
+		if (_seeds.empty())
+			std::cerr << "Trace has no seed left, replay will differ" << std::endl;
+		else
+		{
+			seed = _seeds.front();
+			_seeds.pop_front();
+		}
+	}
+	return seed;
+}
+
+void Trace::frame(Uint32 now)
+{
+	_out.put(TR_FRAME);
+	writeVar(_out, now - _last);
+	_last = now;
+}
+
+void Trace::event(const SDL_Event &event)
+{
+	switch (event.type)
+	{
+	case SDL_KEYDOWN:
+	case SDL_KEYUP:
+		if (GAME_KEY_WINDOW_ID == event.key.windowID) break;
+		_out.put(SDL_KEYDOWN == event.type ? TR_KEYDOWN : TR_KEYUP);
+		writeVar(_out, (Uint32)event.key.keysym.sym);
+		break;
+	case SDL_MOUSEBUTTONDOWN:
+	case SDL_MOUSEBUTTONUP:
+		_out.put(SDL_MOUSEBUTTONDOWN == event.type ? TR_MOUSEDOWN : TR_MOUSEUP);
+		writeVar(_out, (Uint32)std::max(0, (int)event.button.x));
+		writeVar(_out, (Uint32)std::max(0, (int)event.button.y));
+		break;
+	case SDL_JOYBUTTONDOWN:
+	case SDL_JOYBUTTONUP:
+		_out.put(SDL_JOYBUTTONDOWN == event.type ? TR_JOYDOWN : TR_JOYUP);
+		writeVar(_out, event.jbutton.button);
+		break;
+	case SDL_QUIT:
+		_out.put(TR_QUIT);
+		break;
+	default:
+		break;	//anything else is made by the game and happens again on replay
+	}
+}
+
+Uint32 Trace::nextFrame()
+{
+	return finished() ? 0 : _frames[_frame].delta;
+}
+
+void Trace::feed()
+{
+	if (finished()) return;
+	for (auto &e : _frames[_frame].events)
+	{
+		SDL_Event event = e;
+		SDL_PushEvent(&event);
+	}
+	++_frame;
+}
@@ -0,0 +1,60 @@
+//trace.h
+//
+//Record a session's input and word list seeds to a small binary file, and
+//play it back on the virtual clock, so a slow or broken session can be run
+//again exactly (reword -record / -replay).
+
+#if !defined TRACE_H
+#define TRACE_H
+
+#include <SDL.h>
+
+#include <deque>
+#include <fstream>
+#include <string>
+#include <vector>
+
+class Trace
+{
+public:
+	Trace();
+	~Trace();
+
+	bool record(const std::string &fileName);
+	bool replay(const std::string &fileName);
+	void close();
+
+	bool isRecording() const { return _out.is_open(); }
+	bool isReplaying() const { return _bReplay; }
+
+	//Words::load seed, logged when recording or swapped for the logged one on replay
+	Uint32 seed(Uint32 seed);
+
+	//recording
+	void frame(Uint32 now);				//start of a frame at this game time
+	void event(const SDL_Event &event);	//keeps only the ones replay needs
+
+	//replaying
+	Uint32 nextFrame();					//ms to advance the clock for the next frame
+	void feed();						//push that frame's events into the SDL queue
+	bool finished() const { return _frame >= _frames.size(); }
+
+private:
+	struct SFrame
+	{
+		Uint32					delta;
+		std::vector<SDL_Event>	events;
+	};
+
+	bool load(std::istream &in);
+
+	std::ofstream		_out;
+	Uint32				_last;			//game time of the last recorded frame
+
+	bool				_bReplay;
+	std::vector<SFrame>	_frames;
+	size_t				_frame;			//next frame to replay
+	std::deque<Uint32>	_seeds;
+};
+
+#endif //TRACE_H
@@ -0,0 +1,239 @@
+////////////////////////////////////////////////////////////////////
+/*
+
+File:			tracklibrary.cpp
+
+Class impl:		TrackLibrary
+
+Description:	Music track list and read ahead for Audio. The music directory
+				is read on a worker thread (or the list from last time used, if
+				the directory hasn't changed since), and the tracks next to the
+				one playing are loaded by Mix_LoadMUS on the same worker, so when
+				the music finished hook asks for the next track it is already
+				open and ready to play.
+
+Licence:		This program is free software; you can redistribute it and/or modify
+				it under the terms of the GNU General Public License as published by
+				the Free Software Foundation; either version 2 of the License, or
+				(at your option) any later version.
+
+				This software is distributed in the hope that it will be useful,
+				but WITHOUT ANY WARRANTY; without even the implied warranty of
+				MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+				GNU General Public License for more details.
+
+				You should have received a copy of the GNU General Public License
+				along with this program; if not, write to the Free Software
+				Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+////////////////////////////////////////////////////////////////////
+
+#include "tracklibrary.h"
+#include "helpers.h"
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+#if !defined WIN32
+#include <dirent.h>
+#endif
+
+static const char * TRACK_CACHE = "/.tracks";		//in the music dir, skipped by the scan as it starts with '.'
+static const char * TRACK_CACHE_ID = "reword-tracks";
+
+TrackLibrary::TrackLibrary()
+{
+	_io.start(1);
+}
+
+TrackLibrary::~TrackLibrary()
+{
+	close();
+}
+
+void TrackLibrary::index(const std::string &dir)
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_dir = dir;
+		_names.clear();
+		//anything read ahead from a previous dir is freed on the worker, after its load
+		for (auto &it : _prefetched)
+		{
+			tPrefetch p = it.second;
+			_io.queueJob([p]() { Mix_FreeMusic(p->music); p->music = nullptr; return true; });
+		}
+		_prefetched.clear();
+	}
+	_io.queueJob([this]() { return scan(); });
+}
+
+void TrackLibrary::close()
+{
+	_io.stop();		//finishes any load in progress
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	for (auto &it : _prefetched)
+		Mix_FreeMusic(it.second->music);
+	_prefetched.clear();
+}
+
+size_t TrackLibrary::size()
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _names.size();
+}
+
+std::string TrackLibrary::name(size_t n)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return (n < _names.size()) ? _names[n] : std::string();
+}
+
+//keep (or start loading) the named tracks, anything else loaded is freed
+void TrackLibrary::prefetch(const std::vector<std::string> &names)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	for (auto it = _prefetched.begin(); it != _prefetched.end(); )
+	{
+		if (std::find(names.begin(), names.end(), it->first) == names.end())
+		{
+			//freed on the worker, after its load if still queued
+			tPrefetch p = it->second;
+			_io.queueJob([p]() { Mix_FreeMusic(p->music); p->music = nullptr; return true; });
+			it = _prefetched.erase(it);
+		}
+		else
+			++it;
+	}
+
+	for (auto &n : names)
+	{
+		if (n.empty() || _prefetched.count(n)) continue;
+		tPrefetch p(new SPrefetch);
+		const std::string path = _dir + "/" + n;
+		p->loaded = _io.queueJob([p, path]()
+		{
+			p->music = Mix_LoadMUS(path.c_str());
+			if (!p->music)
+				std::cout << "Failed to load track " << path << " (" << Mix_GetError() << ")" << std::endl;
+			return p->music != nullptr;
+		});
+		_prefetched[n] = p;
+	}
+}
+
+//hand over a prefetched track, waiting if it's still loading (it's normally
+//had the whole of the previous track to get ready)
+Mix_Music * TrackLibrary::take(const std::string &name)
+{
+	tPrefetch p;
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		auto it = _prefetched.find(name);
+		if (it == _prefetched.end())
+			return nullptr;
+		p = it->second;
+		_prefetched.erase(it);
+	}
+	p->loaded.wait();
+	return p->music;
+}
+
+//worker thread - list the .ogg and .mp3 files in the music dir
+bool TrackLibrary::scan()
+{
+	const Uint32 ticks = SDL_GetTicks();
+	std::string dir;
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		dir = _dir;
+	}
+
+	struct stat st;
+	const long dirTime = (stat(dir.c_str(), &st) == 0) ? (long)st.st_mtime : 0;
+	bool bCached = dirTime && readCache(dir, dirTime);
+	if (!bCached)
+	{
+		std::vector<std::string> names;
+#ifndef WIN32
+		struct dirent *ent;
+		DIR *d = opendir(dir.c_str());
+		if (d)
+		{
+			while ((ent = readdir(d)) != nullptr)
+			{
+				std::string sTrack = ent->d_name;
+				if (sTrack.length()>0 && sTrack[0] != '.')
+				{
+					if (pptxt::endsWith(sTrack, "OGG") || pptxt::endsWith(sTrack, "MP3"))
+						names.push_back(sTrack);
+				}
+			}
+			closedir(d);
+		}
+#else
+		//TODO - load tracks on MS box
+#endif
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_names = names;
+		}
+		if (dirTime)
+		{
+			writeCache(dir, dirTime);
+			//creating the cache changes the dir time, so save the new one
+			if (stat(dir.c_str(), &st) == 0 && (long)st.st_mtime != dirTime)
+				writeCache(dir, (long)st.st_mtime);
+		}
+	}
+
+	std::cout << "Music: " << size() << " tracks in " << dir << (bCached ? " (cached)" : "")
+		<< ", " << SDL_GetTicks() - ticks << "ms" << std::endl;
+
+	//the first track Audio will ask for, unless it's asked for something already
+	bool bNone;
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		bNone = _prefetched.empty();
+	}
+	if (bNone && size())
+		prefetch(std::vector<std::string>(1, name(0)));
+	return true;
+}
+
+//the list from last time, if the directory hasn't been changed since
+bool TrackLibrary::readCache(const std::string &dir, long dirTime)
+{
+	std::ifstream in((dir + TRACK_CACHE).c_str());
+	std::string id;
+	long cacheTime = 0;
+	if (!(in >> id >> cacheTime) || id != TRACK_CACHE_ID || cacheTime != dirTime)
+		return false;
+
+	std::vector<std::string> names;
+	std::string line;
+	std::getline(in, line);		//rest of the header
+	while (std::getline(in, line))
+		if (!line.empty()) names.push_back(line);
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	_names = names;
+	return true;
+}
+
+void TrackLibrary::writeCache(const std::string &dir, long dirTime)
+{
+	std::ofstream out((dir + TRACK_CACHE).c_str());
+	if (!out) return;		//read only music dir, scan every time
+	out << TRACK_CACHE_ID << " " << dirTime << std::endl;
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	for (auto &n : _names)
+		out << n << std::endl;
+}
@@ -0,0 +1,56 @@
+//tracklibrary.h
+//
+//The music tracks Audio plays, found and loaded on a worker thread so the
+//game loop never waits on the music directory or a track decode. The track
+//list is cached in the music directory, and the tracks either side of the
+//one playing are loaded ahead, ready for when it ends (or is skipped).
+
+#if !defined TRACKLIBRARY_H
+#define TRACKLIBRARY_H
+
+#include "loader.h"
+
+#include <SDL_mixer.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class TrackLibrary
+{
+public:
+	TrackLibrary();
+	~TrackLibrary();
+
+	void		index(const std::string &dir);		//find the tracks, in the background
+	void		close();							//waits for the worker, frees anything loaded
+
+	size_t		size();								//0 until indexed
+	std::string	name(size_t n);
+
+	void		prefetch(const std::vector<std::string> &names);	//load these, drop any others
+	Mix_Music *	take(const std::string &name);		//caller owns it, nullptr if not prefetched
+
+private:
+	struct SPrefetch
+	{
+		SPrefetch() : music(nullptr) {}
+		Mix_Music *			music;
+		std::future<bool>	loaded;
+	};
+	typedef std::shared_ptr<SPrefetch> tPrefetch;
+
+	bool		scan();								//worker thread
+	bool		readCache(const std::string &dir, long dirTime);
+	void		writeCache(const std::string &dir, long dirTime);
+
+	AsyncLoader	_io;			//one thread, so jobs run in the order queued
+	std::mutex	_mutex;
+	std::string	_dir;
+	std::vector<std::string>	_names;
+	std::map<std::string, tPrefetch>	_prefetched;
+};
+
+#endif //TRACKLIBRARY_H
@@ -42,36 +42,6 @@ Licence:		This program is free software; you can redistribute it and/or modify
 //#include <SDL_image.h>	//for IMG_ functions
 #include <SDL_events.h>
 
-
-RandInt::RandInt()
-{
-//SDL.h may not have been included
-#ifdef _SDL_H
-    #ifdef WIN32
-    #pragma message("RandInt: Using SDL_GetTicks() to seed random\n")
-    #endif
-    setSeed(SDL_GetTicks());
-#else
-    #ifdef WIN32
-    #pragma message("RandInt: Using ctime to seed random\n")
-    #endif
-#endif
-    m_rnd.Randomize();	//uses ctime to seed
-}	//incase setSeed not called
-
-void RandInt::setSeed(unsigned int seed) {
-	m_rnd.SetRandomSeed(seed);
-	m_rnd.Randomize();
-}
-int RandInt::random(int limit)
-{
-	return (int)m_rnd.Random(limit);
-}
-int RandInt::operator() (int limit)	//for sorting calls
-{
-	return (int)m_rnd.Random(limit);
-}
-
 
 /*
 float Utils::round( float x, int places )
@@ -122,8 +92,10 @@ void ppg::pushSDL_EventKey(int key)
 	//push keyboard event instead of user pressing the key
 	//allows us to automate some things
     SDL_Event event;
+    SDL_zero(event);
     //event.type = SDL_KEYDOWN;
     event.key.type = SDL_KEYDOWN;
+    event.key.windowID = GAME_KEY_WINDOW_ID;
     event.key.state = SDL_PRESSED;
     event.key.keysym.sym = (SDL_Keycode)key;
 
@@ -4,7 +4,6 @@
 #define _UTILS_H
 
 #include <SDL.h>
-#include "random.h"
 #include "surface.h"
 
 
@@ -49,20 +48,6 @@ public:
 };
 
 
-class RandInt
-{
-public:
-	RandInt();
-	void setSeed(unsigned int seed);
-	int random(int limit);
-	int operator() (int limit);
-
-	CRandom	m_rnd;					//random number generator class
-};
-
-
-static RandInt g_randInt;
-
 //namespace ppg 	//pp game functions
 //{
 class ppg
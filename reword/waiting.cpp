@@ -31,6 +31,7 @@ Licence:		This program is free software; you can redistribute it and/or modify
 
 #include "global.h"
 #include "waiting.h"
+#include "locator.h"
 
 
 Waiting::Waiting() : _period(0), _start(0), _delay(0)
@@ -53,14 +54,14 @@ void Waiting::start(Uint32 period /*=0*/, Uint32 delay /*=0*/)
 	//unless start() called with new delay and period params
 	_delay = delay;
 
-	_start = SDL_GetTicks();
+	_start = Locator::clock().now();
 }
 
 //test if done, return true if requested time has elapsed, or false if still waiting
 //NOTE: returns true (ie not waiting) if rate not yet set
 bool Waiting::done(bool bReset /*= false*/)
 {
-	bool b = ((SDL_GetTicks() - _start) > _period+_delay);
+	bool b = ((Locator::clock().now() - _start) > _period+_delay);
 	if (bReset && b) start();	//restart wanted and is now done, so restart
 	return b;
 }
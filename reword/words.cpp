@@ -51,6 +51,7 @@ Licence:		This program is free software; you can redistribute it and/or modify
 #include "words.h"
 #include "helpers.h"
 #include "platform.h"
+#include "random.h"
 
 #include <fstream>
 #include <ios>
@@ -59,7 +60,6 @@ Licence:		This program is free software; you can redistribute it and/or modify
 #include <ctime>
 #include <cstdlib>
 #include <iterator>
-#include <random>
 
 #include <string.h>	//for strchr etc
 
@@ -68,13 +68,13 @@ Licence:		This program is free software; you can redistribute it and/or modify
 
 
 Words::Words() :
-	_bList(false), _bDebug(false), _wordFile("")
+	_bList(false), _bDebug(false), _wordFile(""), _alphabet(Alphabet::english())
 {
 	reset();
 }
 
 Words::Words(const std::string &wordFile) :
-	_bList(false), _bDebug(false), _wordFile(wordFile)
+	_bList(false), _bDebug(false), _wordFile(wordFile), _alphabet(Alphabet::english())
 {
 	load(wordFile);	//calls reset() etc
 }
@@ -90,6 +90,16 @@ void Words::reset()
 {
 	//reset all dictionary vars used
 	_mapAll.clear();
+	_vecTarget.clear();		//or a reload would add them all again
+	_vecTarget_it = _vecTarget.begin();
+	for (int b = 0; b < DIF_MAX; ++b)
+	{
+		_bands[b].clear();
+		_bandAt[b] = 0;
+	}
+	_challengeKey = 0;
+	_challenge.clear();
+	_challengeAt = 0;
 
     //and counter stats
 	_stats.clear();
@@ -122,6 +132,8 @@ Words & Words::operator+=(const Words &w)
 					it->second._description = dict._description;
 				if (dict._level > 0)
 					it->second._level = dict._level;
+				if (dict._difficulty > 0)
+					it->second._difficulty = dict._difficulty;
 			}
 		}
 
@@ -209,10 +221,11 @@ bool Words::splitDictLine(std::string text, DictWord &dictword)
 		pptxt::trim(newword, " \r\n\t\'");
 		switch (count)
 		{
-		case 0:	pptxt::makeUpper(newword);
-				dictword._word = newword;
+		case 0:	dictword._word = _alphabet->encode(newword);	//upper case (letter codes)
 				break;
-		case 1:	dictword._level = atoi(newword.c_str());
+		case 1:	dictword._level = atoi(newword.c_str());		//"level" or "level:difficulty"
+				if (newword.find(':') != std::string::npos)
+					dictword._difficulty = atoi(newword.c_str() + newword.find(':') + 1);
 				break;
 		case 2:	if (newword.length() > MAX_REWORD_DESCRIPTION)
                 {
@@ -233,9 +246,7 @@ bool Words::splitDictLine(std::string text, DictWord &dictword)
 //return true if word passed in is not usable in the game due to size or content
 bool Words::rejectWord(const std::string &strWord)
 {
-    const size_t found=strWord.find_first_not_of("ABCDEFGHIJKLMNOPQRSTUVWXYZ");
-    //const size_t found = strWord.find_first_of("\' .-;,");
-	if (found!=std::string::npos)  //ignore words with apostrophies or whitespace
+	if (!_alphabet->isWord(strWord))  //ignore words with apostrophies or whitespace
 	{
 		if (_bDebug) std::cout << "DEBUG: Ignore (\') " << strWord.c_str() << std::endl;
 		return true;
@@ -320,38 +331,137 @@ bool Words::load(const std::string &wordFile, unsigned int rndSeed, unsigned int
 
 		if (_bDebug) std::cout << "Ignored: " << _stats._ignored << std::endl;
 
-        //using restartable rnd function to try re-generate same
-        //random sequence if given same seed again (for resume games)
-		if (rndSeed)
-		{
-			std::mt19937 engine1(rndSeed);
-			std::shuffle(_vecTarget.begin(), _vecTarget.end(), engine1);
-		}
-		else
+		shuffle(rndSeed, startAtWord);
+		return true;
+	}
+
+	std::cerr << "Failed to load word file " << wordFile << std::endl;
+	return false;
+}
+
+//put the target words in a random order, the same order for the same seed
+void Words::shuffle(unsigned int rndSeed, unsigned int startAtWord)
+{
+	//from sorted, not file order, so restart() can do it again without the file
+	std::sort(_vecTarget.begin(), _vecTarget.end());
+
+    //using restartable rnd function to try re-generate same
+    //random sequence if given same seed again (for resume games)
+	Rng rng(rndSeed ? rndSeed : Rng::entropy());
+	std::shuffle(_vecTarget.begin(), _vecTarget.end(), rng);
+
+    if (_bDebug)
+    {
+        //output the start of the sorted list to check order
+        std::cout << "DEBUG: rnd seed = " << rndSeed << std::endl;
+        std::cout << "List first 20 words ... ";
+        std::copy(_vecTarget.begin(), _vecTarget.begin()+std::min<size_t>(20, _vecTarget.size()), std::ostream_iterator<std::string>(std::cout, ", "));	//list first 20
+        std::cout << std::endl;
+    }
+
+	//set the 6word iterator to start (or a specific position)
+	if (startAtWord >=  (unsigned int)_vecTarget.size())
+		startAtWord = 0;	//invalid for size of word llist so just reset to 0
+	_vecTarget_it = _vecTarget.begin() + startAtWord;
+
+	//and the same order within each band, so nextWord() goes straight to the next for its level
+	for (int b = 0; b < DIF_MAX; ++b)
+		_bands[b].clear();
+	for (unsigned int n = 0; n < (unsigned int)_vecTarget.size(); ++n)
+	{
+		tWordMap::const_iterator mapit = _mapAll.find(_vecTarget[n]);
+		const int b = (mapit != _mapAll.end()) ? band(mapit->second) : -1;
+		if (b >= 0) _bands[b].push_back(n);
+	}
+	for (int b = 0; b < DIF_MAX; ++b)
+		_bandAt[b] = std::lower_bound(_bands[b].begin(), _bands[b].end(), startAtWord) - _bands[b].begin();
+}
+
+//the difficulty band (eGameDiff) a target is played in - its level if it has one,
+//else its rated difficulty (1-33 easy, 34-66 medium, 67-99 hard), else 0 for any
+//level. -1 if never played (a level above hard)
+int Words::band(const DictWord &dictWord) const
+{
+	if (dictWord._level > 0)
+		return (dictWord._level < (int)DIF_MAX) ? dictWord._level : -1;
+	if (dictWord._difficulty > 0)
+		return DIF_EASY + (std::min(dictWord._difficulty, 99) - 1) / 33;
+	return DIF_UNDEFINED;
+}
+
+//band to take the next word from - of those at or below the level, the one
+//whose next target comes first in the shuffled list, so the bands play mixed
+//together as the list would. -1 if none are left
+int Words::nextBand(eGameDiff level) const
+{
+	int next = -1;
+	for (int b = 0; b <= std::min((int)level, (int)DIF_MAX - 1); ++b)
+	{
+		if (_bandAt[b] < _bands[b].size()
+			&& (next < 0 || _bands[b][_bandAt[b]] < _bands[next][_bandAt[next]]))
+			next = b;
+	}
+	return next;
+}
+
+//keyed permutation of 0..size-1 - a 4 round Feistel network over the smallest
+//even number of bits that covers size, cycle walking any result past the end
+//back in, so the n'th of the sequence doesn't need the ones before it
+static unsigned int permute(unsigned int key, unsigned int n, unsigned int size)
+{
+	int bits = 2;
+	while (bits < 32 && (1u << bits) < size) bits += 2;
+	const int half = bits / 2;
+	const unsigned int mask = (1u << half) - 1;
+	do
+	{
+		unsigned int left = n >> half, right = n & mask;
+		for (unsigned int round = 0; round < 4; ++round)
 		{
-			std::random_device rd;
-			std::shuffle(_vecTarget.begin(), _vecTarget.end(), rd);
+			unsigned int h = (right + round * 0x9e3779b9u) ^ key;	//round function, a 32 bit mix
+			h ^= h >> 16; h *= 0x7feb352du;
+			h ^= h >> 15; h *= 0x846ca68bu;
+			h ^= h >> 16;
+			const unsigned int next = left ^ (h & mask);
+			left = right;
+			right = next;
 		}
+		n = (left << half) | right;
+	} while (n >= size);
+	return n;
+}
 
-        if (_bDebug)
-        {
-            //output the start of the sorted list to check order
-            std::cout << "DEBUG: rnd seed = " << rndSeed << std::endl;
-            std::cout << "List first 20 words ... ";
-            std::copy(_vecTarget.begin(), _vecTarget.begin()+20, std::ostream_iterator<std::string>(std::cout, ", "));	//list first 20
-            std::cout << std::endl;
-        }
-
-		//set the 6word iterator to start (or a specific position)
-		if (startAtWord >=  (unsigned int)_vecTarget.size())
-			startAtWord = 0;	//invalid for size of word llist so just reset to 0
-		_vecTarget_it = _vecTarget.begin() + startAtWord;
+void Words::setChallenge(unsigned int key, eGameDiff level, unsigned int startAt)
+{
+	_challengeKey = key;
+	_challenge.clear();
+	_challengeAt = startAt;
+	if (!key) return;
 
-		return true;
+	//every target up to the level, as nextWord() would play them in the shuffled list
+	for (auto const& target : _vecTarget)
+	{
+		tWordMap::const_iterator mapit = _mapAll.find(target);
+		const int b = (mapit != _mapAll.end()) ? band(mapit->second) : -1;
+		if (b >= 0 && b <= (int)level) _challenge.push_back(target);
 	}
+	std::sort(_challenge.begin(), _challenge.end());
+	if (_challengeAt >= _challenge.size()) _challengeAt = 0;
+}
 
-	std::cerr << "Failed to load word file " << wordFile << std::endl;
-	return false;
+unsigned int Words::position() const
+{
+	if (_challengeKey) return _challengeAt;
+	return (unsigned int)(_vecTarget_it - _vecTarget.begin());
+}
+
+//same as load(_wordFile, rndSeed, startAtWord) but using the words already loaded
+bool Words::restart(unsigned int rndSeed, unsigned int startAtWord)
+{
+	if (_vecTarget.empty()) return false;
+	clearCurrentWord();
+	shuffle(rndSeed, startAtWord);
+	return true;
 }
 
 //determine if the letters in wordShort are in wordTarget
@@ -460,34 +570,39 @@ bool Words::nextWord(std::string &retln, eGameDiff level,  eGameMode mode, bool
 		//clear internal variables holding current word
 		clearCurrentWord();
 
-		if (_vecTarget_it == _vecTarget.end())
+		std::string target;
+		if (_challengeKey)
 		{
-			//reload the dictionary
-			retln = "";
-			if (!reloadAtEnd || !load()) return false; //reached list end or failed reload
+			//straight to the n'th of the challenge, round again in the same order at the end
+			if (_challenge.empty()) return false;
+			if (_challengeAt >= _challenge.size()) _challengeAt = 0;
+			target = _challenge[permute(_challengeKey, _challengeAt++, (unsigned int)_challenge.size())];
 		}
-
-		mapit = _mapAll.find(*_vecTarget_it);		//find word from vect in the wordTarget dict map
-		if (mapit != _mapAll.end())					//found, so check the level
+		else
 		{
-			if ( (bOk = ((*mapit).second._level <= (int)level)) )//make sure word is at or below current difficulty level
+			//make sure word is at or below current difficulty level
+			int b = nextBand(level);
+			if (b < 0)
 			{
-				if ( (bOk = checkCurrentWordTarget(*_vecTarget_it)) )
-				{
-					//set the "current word" to that just found
-					_word = (*mapit).second;
-
-					if (mode > GM_REWORD)
-					{
-						//quick and dirty to strip non target length words from those just found
-						//as speeder and time trial modes only use the higher target words
-						for (int i=0; i<=TARGET_MAX; ++i)
-							if (i != (int)_word._word.length()) _nWords[i] = 0;	//keep selected word count
-					}
-				}
+				//reload the dictionary
+				retln = "";
+				if (!reloadAtEnd || !load() || (b = nextBand(level)) < 0) return false; //reached list end or failed reload
 			}
+
+			const unsigned int n = _bands[b][_bandAt[b]];
+			_vecTarget_it = _vecTarget.begin() + n + 1;	//next word, as position() for a resume
+			target = _vecTarget[n];
+			//and every band past it, so they all move on together like the one list
+			for (int i = 0; i < DIF_MAX; ++i)
+				while (_bandAt[i] < _bands[i].size() && _bands[i][_bandAt[i]] <= n) ++_bandAt[i];
+		}
+
+		mapit = _mapAll.find(target);		//find word from vect in the wordTarget dict map
+		if (mapit != _mapAll.end())
+		{
+			if ( (bOk = checkCurrentWordTarget(target)) )
+				useWord((*mapit).second, mode);	//set the "current word" to that just found
 		}
-		++_vecTarget_it;	//next word
 	} while (--failsafe>0 && !bOk);
 
 	if (!bOk) _word._word = "XXXXXX";	//err in word list - too many or missing
@@ -498,6 +613,50 @@ bool Words::nextWord(std::string &retln, eGameDiff level,  eGameMode mode, bool
 }
 
 
+void Words::useWord(const DictWord &dictWord, eGameMode mode)
+{
+	_word = dictWord;
+
+	if (mode > GM_REWORD)
+	{
+		//quick and dirty to strip non target length words from those just found
+		//as speeder and time trial modes only use the higher target words
+		for (int i=0; i<=TARGET_MAX; ++i)
+			if (i != (int)_word._word.length()) _nWords[i] = 0;	//keep selected word count
+	}
+}
+
+//make target the current word, as nextWord() would have, without moving on
+bool Words::setWord(const std::string &target, eGameMode mode)
+{
+	clearCurrentWord();
+	tWordMap::const_iterator mapit = _mapAll.find(target);
+	if (mapit == _mapAll.end() || !checkCurrentWordTarget(target))
+	{
+		clearCurrentWord();
+		return false;
+	}
+	useWord(mapit->second, mode);
+	return true;
+}
+
+void Words::getFound(std::vector<bool> &found) const
+{
+	found.clear();
+	for (auto &w : _wordsInTarget)
+		found.push_back(w.second);
+}
+
+//false (and nothing changed) if found isn't for this word list
+bool Words::setFound(const std::vector<bool> &found)
+{
+	if (found.size() != _wordsInTarget.size()) return false;
+	size_t n = 0;
+	for (auto &w : _wordsInTarget)
+		w.second = found[n++];
+	return true;
+}
+
 //test to see if testWord is in the target list and if so set it to 'found'
 //otherwise return a 0 to indicate already found, or -1 for not found.
 int Words::checkWordsInTarget(std::string &testWord)
@@ -509,6 +668,8 @@ int Words::checkWordsInTarget(std::string &testWord)
 		if ((*it).second == true) return 0;	//already found
 		(*it).second = true;	//indicate its now been found
 	}
+	else if (isPersonalWord(testWord) && wordInWord(testWord.c_str(), _word._word.c_str()))
+		return 0;	//the player's own word - not wrong, but not one of the level's either
 	else return -1;	//not found
 
 	return 1;	//found and set to 'found' in list
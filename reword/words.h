@@ -17,6 +17,7 @@
 
 #include "platform.h"
 #include "states.h"
+#include "alphabet.h"
 
 //SDL header for ticks - now NOT included here so we can use with or without SDL libraries
 //include SDL.h in your own code before including words.h if you want to use SDL_GetTicks()
@@ -38,6 +39,7 @@ struct DictWord
 	std::string _description;
 	std::vector<std::string> _prematch;	// a vector of strings found
 	int			_index = 0;			// final index position of word in rw2 file prematch format 
+	int			_difficulty = 0;	// 1..99 rated by rewordlist --difficulty from its sub-words (0=not rated)
 
 	bool		_personal = false;	// a personally entered word (not in dict)
 	bool 		_found = false;		// in-play flag to indicate found/entered by player
@@ -53,6 +55,7 @@ struct DictWord
 		_description.clear();
 		_prematch.clear();
 		_index = 0;
+		_difficulty = 0;
 		_personal = false;
 		_found = false;
 	};
@@ -66,6 +69,7 @@ struct DictWord
 			this->_description = dw._description;
 			this->_prematch = dw._prematch;
 			this->_index = dw._index;
+			this->_difficulty = dw._difficulty;
 			this->_personal = dw._personal;
 			this->_found = dw._found;
 		}
@@ -114,6 +118,8 @@ public:
 	explicit Words(const std::string &wordFile);
 	void setList(bool bOn = true) { _bList = bOn; }
 	void setDebug(bool bOn = true) { _bDebug = bOn; }
+	void setAlphabet(const tAlphabet &alphabet) { _alphabet = alphabet; }	//before load()
+	const Alphabet & alphabet() const { return *_alphabet; }
 
 	bool rejectWord(const std::string &strWord);		//true if word loaded not useable
 	virtual bool rejectDefinition(const DictWord& dictWord) { return false; }
@@ -123,8 +129,30 @@ public:
 				unsigned int startAtWord = 0);
 	unsigned int wordsLoaded() const { return _stats._total; };		//before exclusions, duff words etc
 	std::size_t size() const { return _mapAll.size(); }	//current size
+	bool isWord(const std::string &word) const { return _mapAll.find(word) != _mapAll.end(); }
+
+	//player's own words, accepted when tried (see checkWordsInTarget()) but never
+	//needed to finish a level, scored or used as targets, so they can't change the game
+	void setPersonal(const tWordSet &words) { _personalWords = words; }
+	bool isPersonalWord(const std::string &word) const { return _personalWords.count(word) != 0; }
 
 	bool nextWord(std::string &retln, eGameDiff level, eGameMode mode, bool reloadAtEnd=true);
+
+	//resume support - put the list back in the order a seed gave it without
+	//reading the word file again, and pick up a level part way through
+	const std::string & wordFile() const { return _wordFile; }
+	unsigned int position() const;
+	bool restart(unsigned int rndSeed, unsigned int startAtWord);
+
+	//daily challenge - the targets up to a level in an order set by the key (the
+	//date), the same for everyone with the word file. nextWord() works out the
+	//n'th directly, so there's no shuffle, and resuming is just setting n again.
+	//A key of 0 goes back to the shuffled list
+	void setChallenge(unsigned int key, eGameDiff level, unsigned int startAt = 0);
+	unsigned int challenge() const { return _challengeKey; }
+	bool setWord(const std::string &target, eGameMode mode);
+	void getFound(std::vector<bool> &found) const;			//in _wordsInTarget order
+	bool setFound(const std::vector<bool> &found);
 	tWordsInTarget getWordsInTarget() const { return _wordsInTarget; };
 	int wordsOfLength(unsigned int i) const { if (i > TARGET_MAX) return 0; else return _nWords[i]; };
 	int checkWordsInTarget(std::string &testWord);
@@ -144,6 +172,10 @@ protected:
 
 	void reset();
 	void clearCurrentWord();
+	void shuffle(unsigned int rndSeed, unsigned int startAtWord);
+	int band(const DictWord &dictWord) const;
+	int nextBand(eGameDiff level) const;
+	void useWord(const DictWord &dictWord, eGameMode mode);
 	bool checkCurrentWordTarget(const std::string &wordTarget);
 	bool wordInWord(const char* wordShort, const char* wordTarget);
 	int findWordsInWordTarget(tWordMap &shortwords, const char *word6);
@@ -152,6 +184,11 @@ protected:
 	tWordMap 		_mapAll;				//all words - for full wordlist to test against (during game)
 	tWordVect		_vecTarget;				//vector to hold all 6,7,8 letter words in a rnd order (during game)
 	tWordVect::const_iterator _vecTarget_it;//working vect target iterator
+	std::vector<unsigned int> _bands[DIF_MAX];	//_vecTarget positions of the targets in each difficulty band, in order
+	std::size_t		_bandAt[DIF_MAX];		//next of each band to use
+	unsigned int	_challengeKey;			//0 if not a challenge
+	tWordVect		_challenge;				//challenge targets, sorted so the order only depends on the key
+	unsigned int	_challengeAt;			//next of the challenge sequence to play
 	DictWord		_word;					//current 6 letter word to find etc
 	tWordsInTarget 	_wordsInTarget;			//map of sub words (ie 3,4,5,6 letter for word6) with a "found" flag to say player got it
 	int 			_nWords[TARGET_MAX+1];	//count of number of words of each length to be found in 3, 4, 5 & 6 letter word lists
@@ -161,6 +198,8 @@ protected:
 	bool			_bDebug;				//output detail 'debug' to console?
 
 	std::string 	_wordFile;				//saved when load() called to allow nextWord() to reload
+	tWordSet		_personalWords;			//kept apart from _mapAll, so never in _wordsInTarget
+	tAlphabet		_alphabet;				//words are held as its letter codes (A-Z for English)
 
 	Stats           _stats;					// stats to display by rewordlist on completion
 };
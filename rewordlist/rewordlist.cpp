@@ -41,6 +41,7 @@ History:		Version	Date		Change
 				0.5		?
 				0.6		?
 				0.7		01.05.2021	Add Reword2 prematch feature for pre-matched words against targets
+				0.8		19.10.2026	Add .alphabet files for other languages, several built at once
 
 Licence:		This program is free software; you can redistribute it and/or modify
 				it under the terms of the GNU General Public License as published by
@@ -64,12 +65,204 @@ Licence:		This program is free software; you can redistribute it and/or modify
 #include <iostream>
 #include <string>
 #include <set>
+#include <thread>
+#include <vector>
 
 #include "words2.h"
+#include "../reword/alphabet.h"
 #include "../reword/helpers.h"
 
 using namespace std;
 
+//one dictionary to build - its alphabet, inputs and output file
+struct SBuild
+{
+	tAlphabet	alphabet = Alphabet::english();
+	tWordSet	xdxfFiles;
+	tWordSet	txtFiles;
+	tWordSet	txtIncludeFiles;
+	tWordSet	txtExcludeFiles;
+	std::string	outFile;
+	bool		bInput = false;		//any input file given
+};
+
+//options that apply to every dictionary built
+struct SOptions
+{
+	bool bList = false, bDebug = false, bForceDef = false, bXdxfDefOnly = false, bAutoSkillUpd = false, bPrematch = false;
+	bool bExcludeByDef = false, bTrialOutput = false, bReport = false, bDifficulty = false;
+	tWordSet txtDefinitionExcl;
+	int trialWordCount = 0;
+	std::string trialWordFile;
+};
+
+static bool buildWordList(const SOptions &opt, const SBuild &build)
+{
+	Words2 finalWords;
+	finalWords.setAlphabet(build.alphabet);
+	finalWords.setList(opt.bList);
+	finalWords.setDebug(opt.bDebug);
+	finalWords.setAutoSkillUpd(opt.bAutoSkillUpd);
+
+	tWordSet allIncludeWords;
+	if (!build.txtIncludeFiles.empty())
+	{
+		std::cout << "Adding include list" << std::endl;
+		for (auto const& fileName : build.txtIncludeFiles)
+		{
+			Words2 includeWords(fileName, build.alphabet);
+			auto iOrig = finalWords.size();
+			finalWords += includeWords;	//add any forced include words
+
+			// save include words lists, for later definition exclusions to ignore
+			tWordSet ws = includeWords.getWordSet();
+			allIncludeWords.insert(ws.begin(), ws.end());
+
+			std::cout << "Included " << finalWords.size() - iOrig << " words from '" << fileName << "'" << std::endl;
+		}
+		finalWords += allIncludeWords;
+	}
+
+	if (!build.txtFiles.empty())
+	{
+		//load the named wordlists (with or without level and definition values)
+		//Must be done before xdxf dictionaries as xdxf contain possible definitions
+		//for the words in the wordlist files.
+		auto iOrig = finalWords.size();
+		for (auto const& fileName : build.txtFiles)
+		{
+			std::cout << "Adding wordlist .txt file '" << fileName << "'" << std::endl;
+			Words2 txtWords;
+			txtWords.setAlphabet(build.alphabet);
+			if (opt.bExcludeByDef)
+			{
+				// prepare the internal list of definition exclusion text(s) and any
+				// must-include words from the command line
+				txtWords.setDefinitionExcl(opt.txtDefinitionExcl, allIncludeWords);
+			}
+
+			if (txtWords.load(fileName))
+			{
+				if (opt.bList) std::cout << "Inserting " << txtWords.size() << " words for processing" << std::endl;
+				finalWords += txtWords;	//insert into main list (no dups)
+			}
+		}
+		std::cout << "Added " << finalWords.size() - iOrig << " words using text files" << std::endl;
+	}
+
+	if (!build.xdxfFiles.empty())
+	{
+		//load all the named xdxf dictionary/definition files
+		auto iOrig = finalWords.size();
+		for (auto const& fileName : build.xdxfFiles)
+		{
+			Words2 xdxfWords;
+			xdxfWords.setAlphabet(build.alphabet);
+
+			std::cout << "Adding .xdxf dictionary file '" << fileName << "' ";
+			if (opt.bXdxfDefOnly && finalWords.size() > 0)
+			{
+				std::cout << "for definitions only";
+				xdxfWords = finalWords; //preload with wordlist to populate definitions
+			}
+			std::cout << std::endl;
+
+			if (xdxfWords.xdxfBuildDict(fileName, opt.bForceDef, opt.bXdxfDefOnly))
+			{
+				if (opt.bXdxfDefOnly)
+				{
+					finalWords = xdxfWords;	    //replace list with poss added definitions
+				}
+				else
+				{
+					if (opt.bList) std::cout << "Inserting " << xdxfWords.size() << " words from xdxf file" << std::endl;
+					finalWords += xdxfWords;	//insert into main list (no dups)
+				}
+			}
+		}
+		std::cout << "Added " << finalWords.size() - iOrig << " words using xdxf dictionary files" << std::endl;
+	}
+
+	if (!build.txtExcludeFiles.empty())
+	{
+		std::cout << "Adding exclude list" << std::endl;
+		for (auto const& fileName : build.txtExcludeFiles)
+		{
+			Words2 excludeWords(fileName, build.alphabet);
+			auto iOrig = finalWords.size();
+			finalWords -= excludeWords;	//remove any forced exclude words
+			std::cout << "Excluded " << iOrig - finalWords.size() << " words from '" << fileName << "'" << std::endl;
+		}
+	}
+
+	if (finalWords.size() == 0)
+	{
+		std::cout << "Nothing to output." << std::endl;
+		return false;
+	}
+
+	std::cout << "Output from " << finalWords.size() << " words" << std::endl;
+	if (opt.bTrialOutput)
+	{
+		if (opt.trialWordCount)
+		{
+			std::cout << "Trial dictionary filter for " << opt.trialWordCount << " words." << std::endl;
+			if (!finalWords.trialFilterByCount(opt.trialWordCount))
+			{
+				std::cout << "Trial dictionary filter (-t<" << opt.trialWordCount << ">) produced no output." << std::endl;
+				return false;
+			}
+		}
+		else
+		{
+			std::cout << "Trial dictionary filter for words in file " << opt.trialWordFile << std::endl;
+			if (!finalWords.trialFilterByFile(opt.trialWordFile))
+			{
+				std::cout << "Trial dictionary filter (-t<" << opt.trialWordFile << ">) produced no output." << std::endl;
+				return false;
+			}
+		}
+	}
+	else
+	{
+		//now all list and xdxf words added internally, filter out words
+		//not needed due to not found in bigger words etc
+		finalWords.filterGameWords();
+	}
+
+	//rate the targets before the report and save, which both include it
+	if (opt.bDifficulty)
+	{
+		finalWords.rateDifficulty();
+	}
+
+	// discover and prepare for saving, any prematch words
+	// so game doesn't have to find the list of match words on the fly
+	if (opt.bPrematch)
+	{
+		finalWords.prematch();
+	}
+
+	if (opt.bReport)
+	{
+		//rewordlist.report.json and .csv alongside rewordlist.txt
+		const std::string stem = build.outFile.substr(0, build.outFile.find_last_of('.'));
+		finalWords.report(stem + ".report");
+	}
+
+	//save it
+	if (finalWords.save(build.outFile, opt.bPrematch))
+	{
+		std::cout << std::endl << "Created '" << build.outFile << "'";
+		//std::copy( txtFiles.begin(), txtFiles.end(), std::ostream_iterator< std::string >( std::cout, "," ) );
+		//std::copy( xdxfFiles.begin(), xdxfFiles.end(), std::ostream_iterator< std::string >( std::cout, "," ) );
+		std::cout << std::endl << "Place this file in the data/words/ directory of the Reword game" << std::endl;
+		return true;
+	}
+	std::cout << std::endl << "Error: Unable to filter word lists into " << build.outFile << std::endl;
+	return false;
+}
+
 //undefine sdl main definition if sdl has been included in a embedded include
 //otherwise sdl defines main as SDL_Main and linker fails to find _main
 #ifdef _SDL_H
@@ -77,19 +270,14 @@ using namespace std;
 #endif
 int main(int argc, char* argv[])
 {
-	bool bList(false), bDebug(false), bForceDef(false), bXdxfDefOnly(false), bAutoSkillUpd(false), bPrematch(false);
-	bool bHelp(true), bHelpForce(false), bExcludeByDef(false), bTrialOutput(false);
+	SOptions opt;
+	bool bHelp(true), bHelpForce(false);
 	std::string::size_type pos;
-	tWordSet xdxfFiles;
-	tWordSet txtFiles;
-	tWordSet txtIncludeFiles;
-	tWordSet txtExcludeFiles;
-	tWordSet txtDefinitionExcl;
 	const std::string default_outfile("rewordlist.txt");
 	const std::string default_outfile_rw2("rewordlist.rw2");
-	std::string outFile(default_outfile);
-	int trialWordCount = 0;
-	std::string trialWordFile;
+
+	//each .alphabet file starts another dictionary, built from the files after it
+	std::vector<SBuild> builds(1);
 
 	//v. simple loop to load cmd line args - in any order,
 	//but must be separately 'dashed' ie. -l -f not -lf
@@ -101,36 +289,44 @@ int main(int argc, char* argv[])
 			bHelp = bHelpForce = true;  //show help page
 			continue;
 		}
+		if ("--report" == arg)
+		{
+			opt.bReport = true;		//dictionary statistics as json and csv
+			continue;
+		}
+		if ("--difficulty" == arg)
+		{
+			opt.bDifficulty = true;	//rate each target 1..99, saved as level:difficulty
+			continue;
+		}
 		if ("-l" == arg)
 		{
-			bList = true;       //display more debug info
+			opt.bList = true;       //display more debug info
 			continue;
 		}
 		if ("-d" == arg)
 		{
-			bDebug = true;      //display extra debug info
+			opt.bDebug = true;      //display extra debug info
 			continue;
 		}
 		if ("-f" == arg)
 		{
-			bForceDef = true;   //create/overwrite definitions from included inputs
+			opt.bForceDef = true;   //create/overwrite definitions from included inputs
 			continue;
 		}
 		if ("-x" == arg)
 		{
-			bXdxfDefOnly = true;	//use xdxf files passed in for definitions only
+			opt.bXdxfDefOnly = true;	//use xdxf files passed in for definitions only
 			continue;
 		}
 		if ("-s" == arg)
 		{
-			bAutoSkillUpd = true;    //update word scrabble skill value on any word list input
+			opt.bAutoSkillUpd = true;    //update word scrabble skill value on any word list input
 			continue;
 		}
 		if ("-p" == arg)		// prematch words and add to output
 		{
-			bPrematch = true;
-			if (outFile == default_outfile)
-				outFile = default_outfile_rw2;
+			opt.bPrematch = true;
 			continue;
 		}
 
@@ -138,8 +334,8 @@ int main(int argc, char* argv[])
 		{
 			if (arg.length() > 2)
 			{
-				bExcludeByDef = true;
-				txtDefinitionExcl.insert(arg.substr(2));
+				opt.bExcludeByDef = true;
+				opt.txtDefinitionExcl.insert(arg.substr(2));
 			}
 			continue;
 		}
@@ -160,57 +356,69 @@ int main(int argc, char* argv[])
 					std::cout << std::endl << "Numeric value " << len << "out of range for patam t (1-n)" << std::endl;
 					exit(0);
 				}
-				trialWordCount = len;
+				opt.trialWordCount = len;
 			}
 			catch (const std::exception& e)
 			{
-				trialWordFile = arg2;
+				opt.trialWordFile = arg2;
 			}
-			bTrialOutput = true;
+			opt.bTrialOutput = true;
 			continue;
 		}
 		if ("-o" == arg.substr(0, 2))    //e.g. "-oOutputFile.txt"
 		{
 			if (arg.substr(2).length())
-				outFile = arg.substr(2);
+				builds.back().outFile = arg.substr(2);
 			else
-				std::cout << std::endl << "Output filename not specified, defualting to " << outFile << std::endl;
+				std::cout << std::endl << "Output filename not specified, using the default" << std::endl;
 			continue;
 		}
 		pos = arg.find_last_of('.');		//find the last period for file extension
 		if (pos == string::npos) continue;	//unknown (doesn't end in a file extension)
 		std::string ext(arg.substr(pos));
 
+		SBuild &build = builds.back();
+
+		//a language for the following files
+		if (".alphabet" == ext)
+		{
+			std::shared_ptr<Alphabet> alphabet(new Alphabet());
+			if (!alphabet->load(arg))
+				exit(0);
+			if (build.bInput || build.alphabet != Alphabet::english())
+				builds.push_back(SBuild());
+			builds.back().alphabet = alphabet;
+			continue;
+		}
 		//allow multiple input .xdxf files
 		if (".xdxf" == ext)
 		{
-			xdxfFiles.insert(arg);
+			build.xdxfFiles.insert(arg);
+			build.bInput = true;
 			bHelp = false;	//valid input
 			continue;
 		}
 		//allow multiple input .txt files
 		if (".txt" == ext)
 		{
-			if (strcasecmp(arg.c_str(), outFile.c_str()) == 0)
-			{
-				std::cout << std::endl << outFile << " cannot be used as an input and output file" << std::endl;
-				exit(0);
-			}
-			txtFiles.insert(arg);
+			build.txtFiles.insert(arg);
+			build.bInput = true;
 			bHelp = false;	//valid input
 			continue;
 		}
 		//allow multiple .include file
 		if (".include" == ext)
 		{
-			txtIncludeFiles.insert(arg);
+			build.txtIncludeFiles.insert(arg);
+			build.bInput = true;
 			bHelp = false;	//valid input
 			continue;
 		}
 		//allow multiple .exclude file
 		if (".exclude" == ext)
 		{
-			txtExcludeFiles.insert(arg);
+			build.txtExcludeFiles.insert(arg);
+			build.bInput = true;
 			bHelp = false;	//valid input
 			continue;
 		}
@@ -218,179 +426,75 @@ int main(int argc, char* argv[])
 		//else ignore anything else for now
 	}
 	if (bHelpForce) bHelp = true;	//overrides
-	
-	if (bPrematch)
-	{
-		// force prematch output files to end with .rw2 as it breaks the old "WORD|level|description" format
-		// Just append it so up to user to rename if required.
-		const std::string ext = ".rw2";
-		if (!pptxt::endsWith(outFile, ext, true) && outFile.size() >= ext.size())
-		{
-			outFile += ext;
-			std::cout << "Prematch selected so forcing output extension to .rw2 (" << outFile << ")" << std::endl;
-		}
-	}
 
-	if (!bHelp)
+	for (auto &build : builds)
 	{
-		std::cout << "Working..." << std::endl;
-
-		Words2 finalWords;
-		finalWords.setList(bList);
-		finalWords.setDebug(bDebug);
-		finalWords.setAutoSkillUpd(bAutoSkillUpd);
-
-		tWordSet allIncludeWords;
-		if (!txtIncludeFiles.empty())
+		if (build.outFile.empty())
 		{
-			std::cout << "Adding include list" << std::endl;
-			for (auto const& fileName : txtIncludeFiles)
-			{
-				Words2 includeWords(fileName);
-				auto iOrig = finalWords.size();
-				finalWords += includeWords;	//add any forced include words
-
-				// save include words lists, for later definition exclusions to ignore
-				tWordSet ws = includeWords.getWordSet();
-				allIncludeWords.insert(ws.begin(), ws.end());
-
-				std::cout << "Included " << finalWords.size() - iOrig << " words from '" << fileName << "'" << std::endl;
-			}
-			finalWords += allIncludeWords;
+			//rewordlist.txt, or rewordlist_<name>.txt if building more than one
+			const std::string &def = opt.bPrematch ? default_outfile_rw2 : default_outfile;
+			build.outFile = def;
+			if (builds.size() > 1)
+				build.outFile = def.substr(0, def.find_last_of('.')) + "_" + build.alphabet->name() + def.substr(def.find_last_of('.'));
 		}
-
-		if (!txtFiles.empty())
+		else if (opt.bPrematch)
 		{
-			//load the named wordlists (with or without level and definition values)
-			//Must be done before xdxf dictionaries as xdxf contain possible definitions
-			//for the words in the wordlist files.
-			auto iOrig = finalWords.size();
-			for (auto const& fileName : txtFiles)
+			// force prematch output files to end with .rw2 as it breaks the old "WORD|level|description" format
+			// Just append it so up to user to rename if required.
+			const std::string ext = ".rw2";
+			if (!pptxt::endsWith(build.outFile, ext, true) && build.outFile.size() >= ext.size())
 			{
-				std::cout << "Adding wordlist .txt file '" << fileName << "'" << std::endl;
-				Words2 txtWords;
-				if (bExcludeByDef)
-				{
-					// prepare the internal list of definition exclusion text(s) and any
-					// must-include words from the command line
-					txtWords.setDefinitionExcl(txtDefinitionExcl, allIncludeWords);
-				}
-
-				if (txtWords.load(fileName))
-				{
-					if (bList) std::cout << "Inserting " << txtWords.size() << " words for processing" << std::endl;
-					finalWords += txtWords;	//insert into main list (no dups)
-				}
+				build.outFile += ext;
+				std::cout << "Prematch selected so forcing output extension to .rw2 (" << build.outFile << ")" << std::endl;
 			}
-			std::cout << "Added " << finalWords.size() - iOrig << " words using text files" << std::endl;
 		}
 
-		if (!xdxfFiles.empty())
+		for (auto const& fileName : build.txtFiles)
 		{
-			//load all the named xdxf dictionary/definition files
-			auto iOrig = finalWords.size();
-			for (auto const& fileName : xdxfFiles)
+			if (strcasecmp(fileName.c_str(), build.outFile.c_str()) == 0)
 			{
-				Words2 xdxfWords;
-
-				std::cout << "Adding .xdxf dictionary file '" << fileName << "' ";
-				if (bXdxfDefOnly && finalWords.size() > 0)
-				{
-					std::cout << "for definitions only";
-					xdxfWords = finalWords; //preload with wordlist to populate definitions
-				}
-				std::cout << std::endl;
-
-				if (xdxfWords.xdxfBuildDict(fileName, bForceDef, bXdxfDefOnly))
-				{
-					if (bXdxfDefOnly)
-					{
-						finalWords = xdxfWords;	    //replace list with poss added definitions
-					}
-					else
-					{
-						if (bList) std::cout << "Inserting " << xdxfWords.size() << " words from xdxf file" << std::endl;
-						finalWords += xdxfWords;	//insert into main list (no dups)
-					}
-				}
+				std::cout << std::endl << build.outFile << " cannot be used as an input and output file" << std::endl;
+				exit(0);
 			}
-			std::cout << "Added " << finalWords.size() - iOrig << " words using xdxf dictionary files" << std::endl;
 		}
+	}
 
-		if (!txtExcludeFiles.empty())
-		{
-			std::cout << "Adding exclude list" << std::endl;
-			for (auto const& fileName : txtExcludeFiles)
-			{
-				Words2 excludeWords(fileName);
-				auto iOrig = finalWords.size();
-				finalWords -= excludeWords;	//remove any forced exclude words
-				std::cout << "Excluded " << iOrig - finalWords.size() << " words from '" << fileName << "'" << std::endl;
-			}
-		}
+	if (!bHelp)
+	{
+		std::cout << "Working..." << std::endl;
 
-		if (finalWords.size() == 0)
-		{
-			std::cout << "Nothing to output." << std::endl;
-		}
+		if (builds.size() == 1)
+			buildWordList(opt, builds[0]);
 		else
 		{
-			std::cout << "Output from " << finalWords.size() << " words" << std::endl;
-			if (bTrialOutput)
+			//each language is separate, so build them all at once
+			std::vector<std::thread> threads;
+			for (auto const& build : builds)
 			{
-				if (trialWordCount)
+				if (!build.bInput)
 				{
-					std::cout << "Trial dictionary filter for " << trialWordCount << " words." << std::endl;
-					if (!finalWords.trialFilterByCount(trialWordCount))
-					{
-						std::cout << "Trial dictionary filter (-t<" << trialWordCount << ">) produced no output." << std::endl;
-						exit(0);
-					}
+					std::cout << "No input files for alphabet '" << build.alphabet->name() << "'" << std::endl;
+					continue;
 				}
-				else
-				{
-					std::cout << "Trial dictionary filter for words in file " << trialWordFile << std::endl;
-					if (!finalWords.trialFilterByFile(trialWordFile))
-					{
-						std::cout << "Trial dictionary filter (-t<" << trialWordFile << ">) produced no output." << std::endl;
-						exit(0);
-					}
-				}
-			}
-			else
-			{
-				//now all list and xdxf words added internally, filter out words
-				//not needed due to not found in bigger words etc
-				finalWords.filterGameWords();
-			}
-
-			// discover and prepare for saving, any prematch words
-			// so game doesn't have to find the list of match words on the fly
-			if (bPrematch)
-			{
-				finalWords.prematch();
+				std::cout << "Building '" << build.outFile << "' with alphabet '" << build.alphabet->name() << "'" << std::endl;
+				threads.push_back(std::thread([&opt, &build]() { buildWordList(opt, build); }));
 			}
-
-			//save it
-			if (finalWords.save(outFile, bPrematch))
-			{
-				std::cout << std::endl << "Created '" << outFile << "'";
-				//std::copy( txtFiles.begin(), txtFiles.end(), std::ostream_iterator< std::string >( std::cout, "," ) );
-				//std::copy( xdxfFiles.begin(), xdxfFiles.end(), std::ostream_iterator< std::string >( std::cout, "," ) );
-				std::cout << std::endl << "Place this file in the data/words/ directory of the Reword game" << std::endl;
-			}
-			else
-				std::cout << std::endl << "Error: Unable to filter word lists into " << outFile << std::endl;
+			for (auto &t : threads)
+				t.join();
 		}
 	}
 
 	if (bHelp)
 	{
-		std::cout << "Utility (version 0.7) to generate rewordlist.txt for the reword game." << std::endl
+		std::cout << "Utility (version 0.8) to generate rewordlist.txt for the reword game." << std::endl
 				<< "Useage:" << std::endl
-				<< "rewordlist [<words>.txt] [<words>.include] [<words>.exclude] [<dictionary>.xdxf|...] [-f] [-l] [-d] [-x] [-s] [-p] [-e<text>] [-t[<n>|<filename>]] [-o<outputfile>]" << std::endl
+				<< "rewordlist [<lang>.alphabet] [<words>.txt] [<words>.include] [<words>.exclude] [<dictionary>.xdxf|...] [-f] [-l] [-d] [-x] [-s] [-p] [-e<text>] [-t[<n>|<filename>]] [-o<outputfile>] [--report] [--difficulty] [<lang>.alphabet ...]" << std::endl
 				<< std::endl
 				<< "  Params:  " << std::endl
+				<< "  lang.alphabet defines the letters, case and letter scores of a language (see readme)" << std::endl
+				<< "        files after it are built into one dictionary for that language, and each" << std::endl
+				<< "        further .alphabet starts another dictionary, all built at the same time" << std::endl
+				<< "        (default is English A-Z)" << std::endl
 				<< "  words.txt is a simple one word per line wordlist, which may include |diff|def " << std::endl
 				<< "        (omit, if creating rewordlist.txt directly from xdxf)" << std::endl
 				//				<< "        (Also, can be rewordlist.txt from a prev. run to add xdxf etc, see readme)" << std::endl
@@ -406,12 +510,17 @@ int main(int argc, char* argv[])
 				<< "  -p to generate pre-matched words in the output dictionary (output to .rw2)" << std::endl
 				<< "  -e<param> to exclude words based on specific text found in the word definition (e.g. abbr.)" << std::endl
 				<< "  -t<param> to build a trial dictionary output of <n> words at random from words.txt or specify a wordslist input <filename>" << std::endl
-				<< "  -o to name an output file e.g. -oNewDict.txt" << std::endl
+				<< "  -o to name an output file e.g. -oNewDict.txt (for the dictionary of the .alphabet before it)" << std::endl
+				<< "  --report to also write statistics of the output (sub-word counts, levels, definitions)" << std::endl
+				<< "        to <outputfile>.report.json and a line per target to <outputfile>.report.csv" << std::endl
+				<< "  --difficulty to rate each target 1..99 from its sub-words, output as level:difficulty" << std::endl
+				<< "        (the game picks targets without a level by it: 1-33 easy, 34-66 medium, 67-99 hard)" << std::endl
 				<< std::endl
 				<< "e.g." << std::endl
 				<< "If just a xdxf file given, use that to create rewordlist.txt with definitions" << std::endl
 				<< "If just a wordlist txt file given, create just a filtered rewordlist.txt" << std::endl
-				<< "If a wordlist text file and a xdxf given, use both to create rewordlist.txt with definitions" << std::endl;
+				<< "If a wordlist text file and a xdxf given, use both to create rewordlist.txt with definitions" << std::endl
+				<< "rewordlist en.alphabet en.txt -oen.txt de.alphabet de.txt -ode.txt builds both at once" << std::endl;
 		return 0;
 	}
 
@@ -42,12 +42,16 @@ Licence:		This program is free software; you can redistribute it and/or modify
 #include <ios>
 #include <iostream>
 #include <stdio.h>
-#include <regex>
 #include <algorithm>
 #include <array>
-#include <random>
+#include <bitset>
+#include <cmath>
+#include <functional>
+#include <iterator>
+#include <thread>
 
 #include "words2.h"
+#include "../reword/random.h"
 #include "../reword/helpers.h"	//string helpers etc
 
 
@@ -56,8 +60,9 @@ Words2::Words2()
 	_countXdxfWords = _countXdxfSkipped = _countXdxfMatched = _countXdxfMissing = 0;
 }
 
-Words2::Words2(const std::string& wordFile)
+Words2::Words2(const std::string& wordFile, const tAlphabet &alphabet)
 {
+	setAlphabet(alphabet);
 	load(wordFile);	//calls reset() etc
 }
 
@@ -201,8 +206,8 @@ TiXmlElement* Words2::xdxfNextWord(TiXmlElement* ar, std::string& word, std::str
 			if (tmpElement->ValueStr() == "k")
 			{
 				++_countXdxfWords;
-				word = tmpElement->GetText();	//get the <k>WORD</k>
-				pptxt::makeUpper(word);			//force to UPPER case (def tests against it, below)
+				//get the <k>WORD</k>, in UPPER case letter codes (def tests against it, below)
+				word = _alphabet->encode(tmpElement->GetText(), true);	//strip any non letters
 			}
 			//else ignore; dont care about <b> or <c> etc
 		}
@@ -217,8 +222,7 @@ TiXmlElement* Words2::xdxfNextWord(TiXmlElement* ar, std::string& word, std::str
 			//where the "abbacy " part is not required for the game,
 			//as it's already shown so try and remove it.
 			std::string::size_type pos = def.find_first_of(" ");
-			std::string prefix = def.substr(0, pos);	//may contain other chars, if so those words will stay
-			pptxt::makeUpper(prefix);
+			const std::string prefix = _alphabet->encode(def.substr(0, pos), true);
 			if (word == prefix)
 				def = def.substr(pos);
 
@@ -260,9 +264,7 @@ bool Words2::xdxfBuildDict(const std::string& dictFile, bool bUpdateDef, bool bX
 		{
 			if ((ar = xdxfNextWord(ar, word, def)))
 			{
-				_stats._total++;
-				pptxt::makeAlpha(word);			//strip any non a-z chars
-				pptxt::makeUpper(word);			//force to UPPER case
+				_stats._total++;					//word already letter codes only
 
 				//if we're only updating existing words, with definitions from the xdxf
 				//dictionary, don't add words just find them and poss update the definition.
@@ -394,8 +396,8 @@ bool Words2::trialFilterByCount(int trialWordCount)
 	for (auto set : _wordSet)
 		set.clear();
 
-	std::random_device rd;
-	std::shuffle(_vecTarget.begin(), _vecTarget.end(), rd);
+	Rng rng(Rng::entropy());
+	std::shuffle(_vecTarget.begin(), _vecTarget.end(), rng);
 
 	for (const auto& target : _vecTarget)
 	{
@@ -523,29 +525,29 @@ EE, OO, NN, SS, ...    any double letter ?
 */
 #define SCORE_EASY_THRESHOLD    7
 #define SCORE_MED_THRESHOLD     12
-int Words2::calcScrabbleSkillLevel(const std::string& word)
+int Words2::calcScrabbleSkillLevel(const std::string& word, bool bCount)
 {
 	if (word.length() < TARGET_MIN || word.length() > TARGET_MAX)
 		return 0;   //only 6...8 currently scored
 
-	//remove digraphs and trigraphs
-	std::regex re(R"((BLE|CH|CK|CI|IGH|ING|OUS|QU|RH|SH|SCH|SC|TH|WH|WR|BB|CC|DD|EE|FF|GG|LL|MM|NN|OO|PP|RR|SS|TT|UU|WW|ZZ)*)");
-	std::string out = std::regex_replace(word, re, "");
+	//remove digraphs and trigraphs (the alphabet's stems)
+	std::string out = _alphabet->stem(word);
 
-    //**English** language Scrabble letter scoring
-	const std::array<int, 26> scores = { 1,3,3,2,1,4,2,4,1,8,5,1,3,1,1,3,10,1,1,1,1,4,4,8,4,10 };
+    //letter scores of the alphabet, Scrabble scores for English
     //count up the letter score
     int iTotal(0);
-    for (int i = 0; i < static_cast<int>(out.length()); ++i) iTotal+=scores[out[i]-65];   //A-Z
+    for (auto c : out) iTotal += _alphabet->score(c);
     //gives a score between 6 (smalest re-word of all 1's) and 80 (largest 8 letter re-word of all 10's)
 
     //need to fine tune the distribution and therfore thresholds
     const int score = (iTotal < SCORE_EASY_THRESHOLD)? 1 : (iTotal < SCORE_MED_THRESHOLD) ? 2 : 3;
-    _stats._countScore[iTotal]++;
+    if (!bCount)
+        return score;	//just looking (and maybe not on the main thread)
+    _stats._countScore[std::min(iTotal, (int)_stats._countScore.size()-1)]++;
     _stats._countLevels[score-1]++;
 
 	if (_bDebug)
-		std::cout << "Scrabble: '" << word << "' -> '" << out << "' score : " << iTotal << " = " << score << std::endl;
+		std::cout << "Scrabble: '" << _alphabet->decode(word) << "' -> '" << _alphabet->decode(out) << "' score : " << iTotal << " = " << score << std::endl;
 
 	return score;
 }
@@ -648,7 +650,10 @@ int Words2::saveWordMap(FILE *& fp, const tWordMap &wmOrig, const tWordSet &wsFi
         //level only defined in .txt files, not .xdxf, unles -s used to auto scrabble score
         const int level = _bAutoSkillUpd ? calcScrabbleSkillLevel(wrd._word) : wrd._level;
 
-		fprintf(fp, "%s|%d|", wrd._word.c_str(), level);
+		fprintf(fp, "%s|%d", _alphabet->decode(wrd._word).c_str(), level);
+		if (wrd._difficulty > 0)
+			fprintf(fp, ":%d", wrd._difficulty);	//read by old games as just the level
+		fprintf(fp, "|");
 			
 		if (bPrematch)
 		{
@@ -715,7 +720,7 @@ bool Words2::save(std::string outFile, bool bPrematch)
 		if (_bAutoSkillUpd)
 		{
 			std::cout << "Auto-skill breakdown:" << std::endl;
-			for (unsigned int as = 0; as < (sizeof(_stats._countScore) / sizeof(int)); ++as)
+			for (unsigned int as = 0; as < _stats._countScore.size(); ++as)
 			{
 				if (_stats._countScore[as])
 					std::cout << "Score: " << as << " has " << _stats._countScore[as] << " words." << std::endl;
@@ -735,6 +740,295 @@ bool Words2::save(std::string outFile, bool bPrematch)
 	return true;
 }
 
+//Every filtered word keyed by its letters in sorted order, so the words in a
+//target are the entries for each of the target's letter subsets - at most 2^8
+//lookups per target instead of testing every word with wordInWord()
+void Words2::buildLetterIndex()
+{
+	_letterIndex.clear();
+	for (int i = SHORTW_MIN; i <= TARGET_MAX; ++i)
+	{
+		for (auto const& word : _wordSet[i])
+		{
+			std::string key(word);
+			std::sort(key.begin(), key.end());
+			_letterIndex[key].push_back(word);
+		}
+	}
+}
+
+//the filtered words (including target itself) made from the target's letters
+void Words2::subWords(const std::string &target, std::vector<std::string> &words) const
+{
+	words.clear();
+	std::string letters(target);
+	std::sort(letters.begin(), letters.end());
+
+	const int len = letters.length();
+	tWordSet keys;		//repeated letters give the same subset more than once
+	std::string key;
+	for (unsigned int mask = 1; mask < (1u << len); ++mask)
+	{
+		if ((int)std::bitset<TARGET_MAX>(mask).count() < SHORTW_MIN) continue;
+		key.clear();
+		for (int i = 0; i < len; ++i)
+			if (mask & (1u << i)) key += letters[i];	//stays sorted
+		if (!keys.insert(key).second) continue;
+
+		auto it = _letterIndex.find(key);
+		if (it != _letterIndex.end())
+			words.insert(words.end(), it->second.begin(), it->second.end());
+	}
+}
+
+static unsigned int workerThreads()
+{
+	return std::max(1u, std::min(std::thread::hardware_concurrency(), 16u));
+}
+
+//run fn(t, nThreads) on each of workerThreads(), for a thread to take every
+//n'th item from t, and wait for them all
+static void runParallel(const std::function<void(unsigned int, unsigned int)> &fn)
+{
+	const unsigned int nThreads = workerThreads();
+	std::vector<std::thread> threads;
+	for (unsigned int t = 0; t < nThreads; ++t)
+		threads.push_back(std::thread(fn, t, nThreads));
+	for (auto &t : threads)
+		t.join();
+}
+
+tWordVect Words2::filteredTargets() const
+{
+	tWordVect targets;
+	for (int i = TARGET_MIN; i <= TARGET_MAX; ++i)
+		targets.insert(targets.end(), _wordSet[i].begin(), _wordSet[i].end());
+	return targets;
+}
+
+//How hard a target is to clear, from what there is to find in it:
+// - few sub-words (scarcity)
+// - sub-words that are in few other targets, so less likely to be known (rarity)
+// - one full length answer rather than several anagrams (ambiguity)
+// - uncommon letters, which are harder to see words in (letter rarity)
+//each 0..1, weighted and scaled to 1..99. Easy is 1-33, medium 34-66 and hard
+//67-99, which Words::nextWord() uses for targets without a level.
+void Words2::rateDifficulty()
+{
+	buildLetterIndex();
+	const tWordVect targets = filteredTargets();
+	std::cout << "Rating difficulty of " << targets.size() << " targets..." << std::endl;
+
+	//how many targets each sub-word is in, each thread counting its own targets
+	std::vector<std::unordered_map<std::string, int>> inTargets(workerThreads());
+	runParallel([this, &targets, &inTargets](unsigned int t, unsigned int nThreads)
+	{
+		std::vector<std::string> words;
+		for (size_t n = t; n < targets.size(); n += nThreads)
+		{
+			subWords(targets[n], words);
+			for (auto const& w : words)
+				inTargets[t][w]++;
+		}
+	});
+	std::unordered_map<std::string, int> containing;
+	for (auto const& counts : inTargets)
+		for (auto const& c : counts)
+			containing[c.first] += c.second;
+
+	//letter frequency over all the filtered words
+	double freq[256] = {0};
+	double maxFreq = 1;
+	for (int i = SHORTW_MIN; i <= TARGET_MAX; ++i)
+		for (auto const& w : _wordSet[i])
+			for (auto c : w)
+				maxFreq = std::max(maxFreq, ++freq[(unsigned char)c]);
+
+	std::vector<int> difficulty(targets.size());
+	runParallel([this, &targets, &containing, &freq, maxFreq, &difficulty](unsigned int t, unsigned int nThreads)
+	{
+		std::vector<std::string> words;
+		for (size_t n = t; n < targets.size(); n += nThreads)
+		{
+			const std::string &target = targets[n];
+			subWords(target, words);
+
+			int found = 0, fullLength = 0;
+			double rarity = 0;
+			for (auto const& w : words)
+			{
+				if (w.length() == target.length())
+				{
+					++fullLength;		//target and its anagrams
+					continue;
+				}
+				++found;
+				rarity += 1.0 / (1.0 + std::log2((double)containing.find(w)->second));
+			}
+			rarity = found ? rarity / found : 1.0;
+			const double scarcity = 1.0 / (1.0 + found / 8.0);
+			const double ambiguity = 1.0 / std::max(1, fullLength);
+
+			double letters = 0;
+			for (auto c : target)
+				letters += freq[(unsigned char)c] / maxFreq;
+			const double letterRarity = 1.0 - letters / target.length();
+
+			const double score = 0.35 * scarcity + 0.25 * rarity + 0.2 * ambiguity + 0.2 * letterRarity;
+			difficulty[n] = std::max(1, std::min(99, (int)std::lround(1 + 98 * score)));
+		}
+	});
+
+	int bands[DIF_MAX] = {0};
+	for (size_t n = 0; n < targets.size(); ++n)
+	{
+		_mapAll[targets[n]]._difficulty = difficulty[n];
+		const int b = band(_mapAll[targets[n]]);
+		if (b >= 0) bands[b]++;	//-1 for a level that's never played
+	}
+	std::cout << "Difficulty Easy: " << bands[DIF_EASY] << ", Med: " << bands[DIF_MED]
+		<< ", Hard: " << bands[DIF_HARD] << " targets (by level or difficulty)" << std::endl;
+}
+
+//Dictionary statistics to tune the difficulty thresholds and word lists with.
+//The sub-words of every target are found in parallel, each thread taking every
+//n'th target and keeping its own totals, which are added up at the end.
+bool Words2::report(const std::string &fileStem)
+{
+	buildLetterIndex();
+
+	const tWordVect targets = filteredTargets();
+
+	struct STotals
+	{
+		std::map<int, int>	subCounts[TARGET_MAX+1];	//[length][sub-words of that length] = targets
+		tWordVect			overCol;		//a displayed column with more than MAX_WORD_COL words
+		tWordVect			noSubWords;		//nothing to find but the target
+	};
+
+	std::cout << "Reporting on " << targets.size() << " targets..." << std::endl;
+	std::vector<STotals> totals(workerThreads());
+	std::vector<std::string> rows(targets.size());		//csv line per target
+	runParallel([this, &targets, &totals, &rows](unsigned int t, unsigned int nThreads)
+	{
+		STotals &tot = totals[t];
+		std::vector<std::string> words;
+		for (size_t n = t; n < targets.size(); n += nThreads)
+		{
+			const std::string &target = targets[n];
+			subWords(target, words);
+
+			int count[TARGET_MAX+1] = {0};
+			for (auto const& w : words)
+				count[w.length()]++;		//target too, as the game shows it
+
+			const int len = target.length();
+			bool bOver = false;
+			int total = 0;
+			for (int i = SHORTW_MIN; i <= len; ++i)
+			{
+				tot.subCounts[i][count[i]]++;
+				total += count[i];
+				if (i > len - MAX_WORD_ROW && count[i] > MAX_WORD_COL) bOver = true;
+			}
+			if (bOver) tot.overCol.push_back(target);
+			if (total == 1) tot.noSubWords.push_back(target);
+
+			auto const &dict = _mapAll.find(target)->second;
+			const int level = _bAutoSkillUpd ? calcScrabbleSkillLevel(target, false) : dict._level;
+			std::string row = _alphabet->decode(target) + "," + std::to_string(level) + ","
+				+ (dict._description.empty() ? "0" : "1") + "," + std::to_string(dict._difficulty);
+			for (int i = SHORTW_MIN; i <= TARGET_MAX; ++i)
+				row += "," + std::to_string(count[i]);
+			row += "," + std::to_string(total) + "," + (bOver ? "1" : "0");
+			rows[n] = row;
+		}
+	});
+
+	STotals sum;
+	for (auto &tot : totals)
+	{
+		for (int i = SHORTW_MIN; i <= TARGET_MAX; ++i)
+			for (auto const& c : tot.subCounts[i])
+				sum.subCounts[i][c.first] += c.second;
+		sum.overCol.insert(sum.overCol.end(), tot.overCol.begin(), tot.overCol.end());
+		sum.noSubWords.insert(sum.noSubWords.end(), tot.noSubWords.begin(), tot.noSubWords.end());
+	}
+	std::sort(sum.overCol.begin(), sum.overCol.end());
+	std::sort(sum.noSubWords.begin(), sum.noSubWords.end());
+
+	//levels and definitions of all the words output, by length
+	int words[TARGET_MAX+1] = {0}, described[TARGET_MAX+1] = {0};
+	int levels[TARGET_MAX+1][DIF_MAX+1] = {{0}};
+	for (int i = SHORTW_MIN; i <= TARGET_MAX; ++i)
+	{
+		for (auto const& w : _wordSet[i])
+		{
+			auto const &dict = _mapAll.find(w)->second;
+			words[i]++;
+			if (!dict._description.empty()) described[i]++;
+			//as save() will write it
+			const int level = _bAutoSkillUpd ? calcScrabbleSkillLevel(w, false) : dict._level;
+			levels[i][(level >= 0 && level <= DIF_MAX) ? level : 0]++;
+		}
+	}
+
+	const std::string csvFile = fileStem + ".csv";
+	std::ofstream csv(csvFile.c_str());
+	csv << "target,level,described,difficulty";
+	for (int i = SHORTW_MIN; i <= TARGET_MAX; ++i)
+		csv << ",words" << i;
+	csv << ",total,over_col" << std::endl;
+	for (auto const& row : rows)
+		csv << row << "\n";
+	csv.close();
+
+	const std::string jsonFile = fileStem + ".json";
+	std::ofstream json(jsonFile.c_str());
+	auto list = [this, &json](const tWordVect &wv)
+	{
+		json << "[";
+		for (size_t n = 0; n < wv.size(); ++n)
+			json << (n ? ", " : "") << "\"" << _alphabet->decode(wv[n]) << "\"";
+		json << "]";
+	};
+	json << "{" << std::endl
+		<< "  \"alphabet\": \"" << _alphabet->name() << "\"," << std::endl
+		<< "  \"targets\": " << targets.size() << "," << std::endl
+		<< "  \"max_word_col\": " << MAX_WORD_COL << "," << std::endl
+		<< "  \"lengths\": {" << std::endl;
+	for (int i = SHORTW_MIN; i <= TARGET_MAX; ++i)
+	{
+		json << "    \"" << i << "\": { \"words\": " << words[i] << ", \"described\": " << described[i]
+			<< ", \"levels\": [";
+		for (int l = 0; l <= DIF_MAX; ++l)
+			json << (l ? ", " : "") << levels[i][l];
+		json << "], \"sub_word_counts\": {";
+		bool bFirst = true;
+		for (auto const& c : sum.subCounts[i])
+		{
+			json << (bFirst ? "" : ", ") << "\"" << c.first << "\": " << c.second;
+			bFirst = false;
+		}
+		json << "} }" << (i < TARGET_MAX ? "," : "") << std::endl;
+	}
+	json << "  }," << std::endl << "  \"over_max_word_col\": ";
+	list(sum.overCol);
+	json << "," << std::endl << "  \"no_sub_words\": ";
+	list(sum.noSubWords);
+	json << std::endl << "}" << std::endl;
+	json.close();
+
+	if (!csv || !json)
+	{
+		std::cout << "Failed to write report " << jsonFile << " / " << csvFile << std::endl;
+		return false;
+	}
+	std::cout << "Report: " << sum.overCol.size() << " targets over " << MAX_WORD_COL << " words a column, "
+		<< sum.noSubWords.size() << " with no sub-words. Written to " << jsonFile << " and " << csvFile << std::endl;
+	return true;
+}
+
 tWordSet Words2::getWordSet() const
 {
 	tWordSet ws;
@@ -9,6 +9,7 @@
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <unordered_map>
 #include "stdio.h"
 
 #include "../reword/words.h"
@@ -19,7 +20,7 @@ class Words2 : public Words
 {
 public:
 	Words2();
-	explicit Words2(const std::string &wordFile);
+	explicit Words2(const std::string &wordFile, const tAlphabet &alphabet = Alphabet::english());
 	~Words2() override;
 
 	//Add words from the xdxf dictionary to the internal lists
@@ -41,6 +42,11 @@ public:
 
 	bool save(std::string outFile, bool bPrematch);
 
+	//statistics of the filtered words, <fileStem>.json summary and <fileStem>.csv per target
+	bool report(const std::string &fileStem);
+	//rate each filtered target 1..99 from its sub-words, saved as "level:difficulty"
+	void rateDifficulty();
+
 	Words2 & operator = (const Words2 &w2);
 	Words2 & operator += (const Words2 &w2);		// add all the important Word2 member vars
 	Words2 & operator += (const tWordSet &ws);		// add just a word list/set
@@ -61,10 +67,14 @@ protected:
 	[[nodiscard]] TiXmlElement* 	xdxfFirstWord() const;
 	[[nodiscard]] TiXmlElement* 	xdxfNextWord(TiXmlElement* ar, std::string &word, std::string &def);
 
-    int calcScrabbleSkillLevel(const std::string &word);
+    int calcScrabbleSkillLevel(const std::string &word, bool bCount = true);	//bCount adds it to _stats
 	void addWordsToSets();	//add to valid sets (one set per word length)
 	int saveWordMap(FILE *& fp, const tWordMap &wmOrig, const tWordSet &wsFilt, bool bPrematch = false);
 
+	void buildLetterIndex();		//of the filtered words, for subWords()
+	void subWords(const std::string &target, std::vector<std::string> &words) const;	//thread safe
+	[[nodiscard]] tWordVect filteredTargets() const;
+
 private:
 
 	TiXmlDocument * _doc = nullptr;
@@ -74,6 +84,7 @@ private:
 	int		_countXdxfMissing = 0;
 
 	tWordSet _wordSet[TARGET_MAX+1];	//use 1..n for actual word length (as index) during rewordlist.txt build
+	std::unordered_map<std::string, tWordVect> _letterIndex;	//words by their sorted letters
 
 	tWordSet _definitionExclSet;		// list of words to check definitions for and exclude words if found (e.g. "abbr." "prefix.")
 	tWordSet _allIncludeWords;			// list of forced include words (used in definition exclusion tests)